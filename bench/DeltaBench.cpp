@@ -0,0 +1,100 @@
+// Times DeltaTracker::compute() with controlled churn: between two
+// alternating tables, 1% of rows are replaced by new pids and 5% move
+// their CPU% past the change threshold.
+//   delta_bench [iterations]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "core/DeltaTracker.hpp"
+#include "core/ProcessColumns.hpp"
+
+static constexpr double REPLACED_FRACTION = 0.01;
+static constexpr double CHANGED_FRACTION = 0.05;
+
+struct Table {
+    ProcessColumns columns;
+    std::vector<long> origin;
+};
+
+static std::vector<Process::State> makeStates(size_t count, std::mt19937& rng) {
+    std::uniform_real_distribution<double> cpu(0.0, 100.0);
+    std::vector<Process::State> states(count);
+    for (size_t i = 0; i < count; ++i) {
+        states[i].pid = static_cast<int>(i + 1);
+        states[i].name = "proc";
+        states[i].cpuUsage = cpu(rng);
+        states[i].memUsage = 1.0;
+        states[i].pssKb = 4096;
+    }
+    return states;
+}
+
+static void assign(ProcessColumns& columns, const std::vector<Process::State>& states) {
+    std::vector<Process> rows(states.begin(), states.end());
+    columns.assign(rows);
+}
+
+static void run(size_t rowCount, int iterations) {
+    std::mt19937 rng(7);
+    std::vector<Process::State> a = makeStates(rowCount, rng);
+    std::vector<Process::State> b = a;
+
+    // b differs from a in a fixed set of rows, so every step sees the same churn.
+    std::vector<size_t> order(rowCount);
+    for (size_t i = 0; i < rowCount; ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), rng);
+    size_t replaced = static_cast<size_t>(rowCount * REPLACED_FRACTION);
+    size_t changed = static_cast<size_t>(rowCount * CHANGED_FRACTION);
+
+    Table tables[2];
+    tables[0].origin.resize(rowCount);
+    tables[1].origin.resize(rowCount);
+    for (size_t i = 0; i < rowCount; ++i) {
+        tables[0].origin[i] = tables[1].origin[i] = static_cast<long>(i);
+    }
+    for (size_t k = 0; k < replaced; ++k) {
+        size_t i = order[k];
+        b[i].pid = static_cast<int>(rowCount + 1 + i);
+        tables[0].origin[i] = tables[1].origin[i] = -1;
+    }
+    for (size_t k = replaced; k < replaced + changed; ++k) {
+        size_t i = order[k];
+        b[i].cpuUsage = a[i].cpuUsage < 50.0 ? a[i].cpuUsage + 10.0 : a[i].cpuUsage - 10.0;
+    }
+    assign(tables[0].columns, a);
+    assign(tables[1].columns, b);
+
+    DeltaTracker tracker;
+    std::vector<int> added;
+    std::vector<ProcessChange> changes;
+    tracker.compute(tables[0].columns, std::vector<long>(rowCount, -1), added, changes);
+
+    std::vector<double> times;
+    times.reserve(static_cast<size_t>(iterations));
+    size_t lastAdded = 0, lastChanged = 0;
+    for (int it = 0; it < iterations; ++it) {
+        const Table& next = tables[(it + 1) % 2];
+        added.clear();
+        changes.clear();
+        auto start = std::chrono::steady_clock::now();
+        tracker.compute(next.columns, next.origin, added, changes);
+        std::chrono::duration<double, std::milli> took = std::chrono::steady_clock::now() - start;
+        times.push_back(took.count());
+        lastAdded = added.size();
+        lastChanged = changes.size();
+    }
+    std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+    std::printf("rows=%-7zu compute %.3f ms (median of %d)  added=%zu changed=%zu\n",
+                rowCount, times[times.size() / 2], iterations, lastAdded, lastChanged);
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 200;
+    for (size_t rows : {10000, 50000, 100000}) {
+        run(rows, iterations);
+    }
+    return 0;
+}
@@ -0,0 +1,81 @@
+// Times the '/' filter on a synthetic process table, once with the few
+// repeated names typical of a real host and once with every name distinct
+// (the worst case for the name dictionary).
+//   filter_bench [rows] [iterations]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "core/FilterExpression.hpp"
+#include "core/ProcessColumns.hpp"
+
+static const char* const EXPRESSION = "cpu > 50 && mem > 5 && name ~ \"java\"";
+
+static std::vector<Process> makeRows(size_t count, bool distinctNames) {
+    static const char* const names[] = {
+        "bash", "systemd", "java", "kworker/0:1", "sshd", "postgres",
+        "JavaUpdateSched", "nginx", "python3", "containerd-shim",
+    };
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> cpu(0.0, 100.0);
+    std::uniform_real_distribution<double> mem(0.0, 10.0);
+
+    std::vector<Process> rows;
+    rows.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        Process::State s;
+        s.pid = static_cast<int>(i + 1);
+        s.name = names[rng() % (sizeof(names) / sizeof(names[0]))];
+        if (distinctNames) s.name += "-" + std::to_string(i);
+        s.cpuUsage = cpu(rng);
+        s.memUsage = mem(rng);
+        s.elapsedTime = static_cast<long>(rng() % 100000);
+        s.pssKb = static_cast<long>(rng() % 1000000);
+        s.ussKb = s.pssKb / 2;
+        rows.emplace_back(s);
+    }
+    return rows;
+}
+
+template <typename Fn>
+static double medianMs(int iterations, Fn&& fn) {
+    std::vector<double> times;
+    times.reserve(static_cast<size_t>(iterations));
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        std::chrono::duration<double, std::milli> took = std::chrono::steady_clock::now() - start;
+        times.push_back(took.count());
+    }
+    std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+    return times[times.size() / 2];
+}
+
+static void run(size_t rowCount, int iterations, bool distinctNames) {
+    std::vector<Process> rows = makeRows(rowCount, distinctNames);
+    ProcessColumns table;
+    FilterExpression filter;
+    filter.compile(EXPRESSION);
+
+    std::vector<uint8_t> mask;
+    double assignMs = medianMs(iterations, [&]{ table.assign(rows); });
+    double evalMs = medianMs(iterations, [&]{ filter.evaluate(table, mask); });
+
+    size_t matched = static_cast<size_t>(std::count(mask.begin(), mask.end(), 1));
+    std::printf("rows=%zu  names=%s\n", rowCount, distinctNames ? "distinct" : "repeated");
+    std::printf("  column refresh  %.3f ms (median of %d)\n", assignMs, iterations);
+    std::printf("  evaluate        %.3f ms (median of %d), %zu matched\n", evalMs, iterations, matched);
+}
+
+int main(int argc, char** argv) {
+    size_t rowCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 200;
+
+    std::printf("expr: %s\n", EXPRESSION);
+    run(rowCount, iterations, false);
+    run(rowCount, iterations, true);
+    return 0;
+}
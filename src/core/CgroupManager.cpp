@@ -0,0 +1,137 @@
+#include "core/CgroupManager.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+static bool isCgroup2Root(const std::string& dir) {
+    return access((dir + "/cgroup.controllers").c_str(), R_OK) == 0;
+}
+
+static double readPressureAvg10(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) return -1.0;
+
+    std::string kind, avg10;
+    while (file >> kind >> avg10) {
+        std::string rest;
+        std::getline(file, rest);
+        if (kind == "some" && avg10.compare(0, 6, "avg10=") == 0) {
+            return std::stod(avg10.substr(6));
+        }
+    }
+    return -1.0;
+}
+
+CgroupManager::CgroupManager() {
+    if (isCgroup2Root("/sys/fs/cgroup")) {
+        sysfsRoot = "/sys/fs/cgroup";
+    } else if (isCgroup2Root("/sys/fs/cgroup/unified")) {
+        sysfsRoot = "/sys/fs/cgroup/unified";
+    }
+}
+
+CgroupStats& CgroupManager::groupFor(const std::string& path) {
+    auto it = indexOf.find(path);
+    if (it != indexOf.end()) return groups[it->second];
+
+    indexOf.emplace(path, groups.size());
+    groups.emplace_back();
+    groups.back().path = path;
+    return groups.back();
+}
+
+void CgroupManager::add(const Process& p) {
+    CgroupStats& g = groupFor(p.getCgroup());
+    ++g.procCount;
+    g.cpuUsage += p.getCpuUsage();
+    g.memUsage += p.getMemUsage();
+}
+
+void CgroupManager::remove(const Process& p) {
+    auto it = indexOf.find(p.getCgroup());
+    if (it == indexOf.end()) return;
+
+    CgroupStats& g = groups[it->second];
+    if (--g.procCount <= 0) {
+        g.procCount = 0;
+        g.cpuUsage = g.memUsage = 0.0;
+    } else {
+        g.cpuUsage -= p.getCpuUsage();
+        g.memUsage -= p.getMemUsage();
+    }
+}
+
+void CgroupManager::update(const Process& p, double oldCpu, double oldMem) {
+    auto it = indexOf.find(p.getCgroup());
+    if (it == indexOf.end()) return;
+
+    CgroupStats& g = groups[it->second];
+    g.cpuUsage += p.getCpuUsage() - oldCpu;
+    g.memUsage += p.getMemUsage() - oldMem;
+}
+
+void CgroupManager::readGroupFiles(CgroupStats& g) {
+    const std::string dir = sysfsRoot + g.path;
+
+    std::ifstream cpuStat(dir + "/cpu.stat");
+    if (cpuStat.is_open()) {
+        std::string key;
+        long value = 0;
+        while (cpuStat >> key >> value) {
+            if (key == "usage_usec") break;
+        }
+        if (key == "usage_usec") {
+            auto now = std::chrono::steady_clock::now();
+            if (g.prevUsageUsec >= 0) {
+                std::chrono::duration<double, std::micro> wall = now - g.prevSampleAt;
+                g.cgroupCpu = wall.count() > 0
+                    ? 100.0 * (value - g.prevUsageUsec) / wall.count()
+                    : 0.0;
+            }
+            g.prevUsageUsec = value;
+            g.prevSampleAt = now;
+        }
+    }
+
+    std::ifstream memCurrent(dir + "/memory.current");
+    long bytes = 0;
+    if (memCurrent.is_open() && memCurrent >> bytes) {
+        g.memoryCurrentKb = bytes / 1024;
+    }
+
+    g.cpuPressure = readPressureAvg10(dir + "/cpu.pressure");
+    g.memPressure = readPressureAvg10(dir + "/memory.pressure");
+}
+
+void CgroupManager::refreshSysfs() {
+    std::vector<CgroupStats> live;
+    live.reserve(groups.size());
+    for (auto& g : groups) {
+        if (g.procCount > 0) live.push_back(std::move(g));
+    }
+    groups = std::move(live);
+
+    indexOf.clear();
+    for (size_t i = 0; i < groups.size(); ++i) {
+        indexOf.emplace(groups[i].path, i);
+    }
+
+    if (sysfsRoot.empty()) return;
+    for (auto& g : groups) {
+        if (g.path.empty() || g.path.front() != '/') continue;
+        readGroupFiles(g);
+    }
+}
+
+void CgroupManager::replaceAll(std::vector<CgroupStats> snapshot) {
+    groups = std::move(snapshot);
+    indexOf.clear();
+    for (size_t i = 0; i < groups.size(); ++i) {
+        indexOf.emplace(groups[i].path, i);
+    }
+}
+
+const std::vector<CgroupStats>& CgroupManager::getGroups() const {
+    return groups;
+}
@@ -0,0 +1,50 @@
+#ifndef HTOP_CLONE_CGROUP_MANAGER_HPP
+#define HTOP_CLONE_CGROUP_MANAGER_HPP
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "core/Process.hpp"
+
+struct CgroupStats {
+    std::string path;
+    int procCount{0};
+    double cpuUsage{0.0};
+    double memUsage{0.0};
+
+    // Read from the cgroup v2 hierarchy; negative when unavailable.
+    double cgroupCpu{-1.0};
+    long memoryCurrentKb{-1};
+    double cpuPressure{-1.0};
+    double memPressure{-1.0};
+
+    long prevUsageUsec{-1};
+    std::chrono::steady_clock::time_point prevSampleAt{};
+};
+
+// Per-cgroup CPU/MEM totals, maintained incrementally from per-process
+// changes rather than re-summed over the whole table every tick.
+class CgroupManager {
+public:
+    CgroupManager();
+
+    void add(const Process& p);
+    void remove(const Process& p);
+    void update(const Process& p, double oldCpu, double oldMem);
+
+    void refreshSysfs();
+    void replaceAll(std::vector<CgroupStats> snapshot);
+
+    const std::vector<CgroupStats>& getGroups() const;
+
+private:
+    std::string sysfsRoot;
+    std::vector<CgroupStats> groups;
+    std::unordered_map<std::string, size_t> indexOf;
+
+    CgroupStats& groupFor(const std::string& path);
+    void readGroupFiles(CgroupStats& g);
+};
+
+#endif
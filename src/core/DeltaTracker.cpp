@@ -0,0 +1,44 @@
+#include "core/DeltaTracker.hpp"
+
+#include <cmath>
+
+void DeltaTracker::compute(const ProcessColumns& rows, const std::vector<long>& origin,
+                           std::vector<int>& added, std::vector<ProcessChange>& changed) {
+    const size_t n = rows.size();
+    const double* pid = rows.numeric(ProcessColumns::PID);
+    const double* cpu = rows.numeric(ProcessColumns::CPU);
+    const double* mem = rows.numeric(ProcessColumns::MEM);
+    const double* pss = rows.numeric(ProcessColumns::PSS);
+
+    nextReported.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        Reported now{cpu[i], mem[i], pss[i]};
+
+        if (origin[i] < 0) {
+            added.push_back(static_cast<int>(pid[i]));
+            nextReported[i] = now;
+            continue;
+        }
+
+        Reported last = reported[static_cast<size_t>(origin[i])];
+        uint8_t fields = 0;
+        if (std::fabs(now.cpu - last.cpu) > CPU_CHANGE_THRESHOLD) {
+            fields |= ProcessChange::CPU;
+            last.cpu = now.cpu;
+        }
+        if (std::fabs(now.mem - last.mem) > MEM_CHANGE_THRESHOLD) {
+            fields |= ProcessChange::MEM;
+            last.mem = now.mem;
+        }
+        if (std::fabs(now.pssKb - last.pssKb) > PSS_CHANGE_THRESHOLD_KB) {
+            fields |= ProcessChange::PSS;
+            last.pssKb = now.pssKb;
+        }
+        if (fields) {
+            changed.push_back({static_cast<int>(pid[i]), static_cast<uint32_t>(i), fields});
+        }
+        nextReported[i] = last;
+    }
+
+    reported.swap(nextReported);
+}
@@ -0,0 +1,37 @@
+#ifndef HTOP_CLONE_DELTA_TRACKER_HPP
+#define HTOP_CLONE_DELTA_TRACKER_HPP
+
+#include <cstdint>
+#include <vector>
+#include "core/ProcessColumns.hpp"
+#include "patterns/Observer.hpp"
+
+// Decides which rows of a refresh are new and which moved far enough from
+// the values last reported for them. It only sees the column table and the
+// row mapping, never /proc, so it can be driven directly by a benchmark.
+class DeltaTracker {
+public:
+    // A row is reported as changed once a metric moves this far from the
+    // value last reported for it, so slow drifts are not lost.
+    static constexpr double CPU_CHANGE_THRESHOLD = 0.5;
+    static constexpr double MEM_CHANGE_THRESHOLD = 0.1;
+    static constexpr double PSS_CHANGE_THRESHOLD_KB = 256;
+
+    // origin[i] is the index of row i in the previous table, or -1 for a
+    // new row. Appends to added and changed.
+    void compute(const ProcessColumns& rows, const std::vector<long>& origin,
+                 std::vector<int>& added, std::vector<ProcessChange>& changed);
+
+private:
+    struct Reported {
+        double cpu;
+        double mem;
+        double pssKb;
+    };
+
+    // Parallel to the table passed to the last compute().
+    std::vector<Reported> reported;
+    std::vector<Reported> nextReported;
+};
+
+#endif
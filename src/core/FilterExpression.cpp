@@ -0,0 +1,433 @@
+#include "core/FilterExpression.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+namespace {
+
+enum class TokKind { IDENT, NUMBER, STRING, OP, END };
+
+struct Token {
+    TokKind kind;
+    std::string text;
+    double number{0.0};
+    bool sized{false};  // number carried a K/M/G suffix
+};
+
+class Parser {
+public:
+    Parser(const std::string& src, std::vector<FilterExpression::Instr>& out)
+        : src(src), out(out) {}
+
+    bool parse(std::string& error) {
+        if (!next(error)) return false;
+        if (tok.kind == TokKind::END) return true;
+        if (!parseOr(error)) return false;
+        if (tok.kind != TokKind::END) {
+            error = "unexpected '" + tok.text + "'";
+            return false;
+        }
+        return true;
+    }
+
+private:
+    const std::string& src;
+    std::vector<FilterExpression::Instr>& out;
+    size_t pos{0};
+    Token tok{TokKind::END, ""};
+
+    bool next(std::string& error) {
+        while (pos < src.size() && std::isspace(static_cast<unsigned char>(src[pos]))) ++pos;
+        if (pos >= src.size()) {
+            tok = {TokKind::END, "end of input"};
+            return true;
+        }
+
+        char c = src[pos];
+        if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            size_t start = pos;
+            while (pos < src.size() &&
+                   (std::isalnum(static_cast<unsigned char>(src[pos])) || src[pos] == '_')) ++pos;
+            tok = {TokKind::IDENT, src.substr(start, pos - start)};
+            return true;
+        }
+        if (std::isdigit(static_cast<unsigned char>(c)) ||
+            (c == '.' && pos + 1 < src.size() && src[pos + 1] != '.')) {
+            size_t start = pos;
+            while (pos < src.size() &&
+                   (std::isdigit(static_cast<unsigned char>(src[pos])) ||
+                    (src[pos] == '.' && !(pos + 1 < src.size() && src[pos + 1] == '.')))) ++pos;
+            double value = std::strtod(src.substr(start, pos - start).c_str(), nullptr);
+            bool sized = false;
+            if (pos < src.size()) {
+                char unit = static_cast<char>(std::toupper(static_cast<unsigned char>(src[pos])));
+                if (unit == 'K')      { value *= 1.0;                ++pos; sized = true; }
+                else if (unit == 'M') { value *= 1024.0;             ++pos; sized = true; }
+                else if (unit == 'G') { value *= 1024.0 * 1024.0;    ++pos; sized = true; }
+            }
+            tok = {TokKind::NUMBER, src.substr(start, pos - start), value, sized};
+            return true;
+        }
+        if (c == '"' || c == '\'') {
+            size_t end = src.find(c, pos + 1);
+            if (end == std::string::npos) {
+                error = "unterminated string";
+                return false;
+            }
+            tok = {TokKind::STRING, src.substr(pos + 1, end - pos - 1)};
+            pos = end + 1;
+            return true;
+        }
+
+        static const char* const twoCharOps[] = {"&&", "||", ">=", "<=", "==", "!=", ".."};
+        for (const char* op : twoCharOps) {
+            if (src.compare(pos, 2, op) == 0) {
+                tok = {TokKind::OP, op};
+                pos += 2;
+                return true;
+            }
+        }
+        if (std::string("<>!~()=").find(c) != std::string::npos) {
+            tok = {TokKind::OP, std::string(1, c)};
+            ++pos;
+            return true;
+        }
+
+        error = std::string("unexpected character '") + c + "'";
+        return false;
+    }
+
+    bool isOp(const char* op) const {
+        return tok.kind == TokKind::OP && tok.text == op;
+    }
+
+    bool parseOr(std::string& error) {
+        if (!parseAnd(error)) return false;
+        while (isOp("||")) {
+            if (!next(error) || !parseAnd(error)) return false;
+            out.push_back({FilterExpression::Op::OR});
+        }
+        return true;
+    }
+
+    bool parseAnd(std::string& error) {
+        if (!parseUnary(error)) return false;
+        while (isOp("&&")) {
+            if (!next(error) || !parseUnary(error)) return false;
+            out.push_back({FilterExpression::Op::AND});
+        }
+        return true;
+    }
+
+    bool parseUnary(std::string& error) {
+        if (isOp("!")) {
+            if (!next(error) || !parseUnary(error)) return false;
+            out.push_back({FilterExpression::Op::NOT});
+            return true;
+        }
+        if (isOp("(")) {
+            if (!next(error) || !parseOr(error)) return false;
+            if (!isOp(")")) {
+                error = "expected ')'";
+                return false;
+            }
+            return next(error);
+        }
+        return parseComparison(error);
+    }
+
+    static bool columnFromName(const std::string& name, FilterExpression::Column& col) {
+        using Column = FilterExpression::Column;
+        if (name == "pid")  { col = Column::PID;  return true; }
+        if (name == "cpu")  { col = Column::CPU;  return true; }
+        if (name == "mem")  { col = Column::MEM;  return true; }
+        if (name == "pss")  { col = Column::PSS;  return true; }
+        if (name == "uss")  { col = Column::USS;  return true; }
+        if (name == "time") { col = Column::TIME; return true; }
+        if (name == "name") { col = Column::NAME; return true; }
+        return false;
+    }
+
+    // K/M/G are KiB multipliers, meaningless for any other column.
+    bool checkSuffix(FilterExpression::Column col, std::string& error) const {
+        using Column = FilterExpression::Column;
+        if (tok.sized && col != Column::PSS && col != Column::USS) {
+            error = "size suffix '" + tok.text + "' only applies to pss and uss";
+            return false;
+        }
+        return true;
+    }
+
+    bool parseComparison(std::string& error) {
+        using Instr = FilterExpression::Instr;
+        using Op = FilterExpression::Op;
+        using Cmp = FilterExpression::Cmp;
+
+        if (tok.kind != TokKind::IDENT) {
+            error = "expected column name, got '" + tok.text + "'";
+            return false;
+        }
+        Instr instr{Op::CMP};
+        if (!columnFromName(tok.text, instr.column)) {
+            error = "unknown column '" + tok.text + "'";
+            return false;
+        }
+        if (!next(error)) return false;
+
+        if (instr.column == FilterExpression::Column::NAME) {
+            if (isOp("~"))                       instr.op = Op::NAME_CONTAINS;
+            else if (isOp("==") || isOp("="))    instr.op = Op::NAME_EQUALS;
+            else {
+                error = "name supports only '~' and '=='";
+                return false;
+            }
+            if (!next(error)) return false;
+            if (tok.kind != TokKind::STRING && tok.kind != TokKind::IDENT) {
+                error = "expected string after name operator";
+                return false;
+            }
+            instr.text = tok.text;
+            if (instr.op == Op::NAME_CONTAINS) {
+                std::transform(instr.text.begin(), instr.text.end(), instr.text.begin(),
+                               [](unsigned char ch){ return std::tolower(ch); });
+            }
+            out.push_back(instr);
+            return next(error);
+        }
+
+        if (tok.kind == TokKind::IDENT && tok.text == "in") {
+            instr.op = Op::RANGE;
+            if (!next(error)) return false;
+            if (tok.kind != TokKind::NUMBER) {
+                error = "expected number after 'in'";
+                return false;
+            }
+            if (!checkSuffix(instr.column, error)) return false;
+            instr.lo = tok.number;
+            if (!next(error)) return false;
+            if (!isOp("..")) {
+                error = "expected '..' in range";
+                return false;
+            }
+            if (!next(error)) return false;
+            if (tok.kind != TokKind::NUMBER) {
+                error = "expected number after '..'";
+                return false;
+            }
+            if (!checkSuffix(instr.column, error)) return false;
+            instr.hi = tok.number;
+            out.push_back(instr);
+            return next(error);
+        }
+
+        if (tok.kind != TokKind::OP) {
+            error = "expected comparison after column";
+            return false;
+        }
+        if      (tok.text == "<")                     instr.cmp = Cmp::LT;
+        else if (tok.text == "<=")                    instr.cmp = Cmp::LE;
+        else if (tok.text == ">")                     instr.cmp = Cmp::GT;
+        else if (tok.text == ">=")                    instr.cmp = Cmp::GE;
+        else if (tok.text == "==" || tok.text == "=") instr.cmp = Cmp::EQ;
+        else if (tok.text == "!=")                    instr.cmp = Cmp::NE;
+        else {
+            error = "unknown operator '" + tok.text + "'";
+            return false;
+        }
+        if (!next(error)) return false;
+        if (tok.kind != TokKind::NUMBER) {
+            error = "expected number, got '" + tok.text + "'";
+            return false;
+        }
+        if (!checkSuffix(instr.column, error)) return false;
+        instr.lo = tok.number;
+        out.push_back(instr);
+        return next(error);
+    }
+};
+
+// Each instruction leaves one byte per row holding a three-valued result:
+// MATCH, MISS, or UNKNOWN when the row has no value for a column it tests
+// (an unsampled PSS/USS). AND/OR/NOT follow Kleene logic, so negating an
+// unknown comparison does not turn it into a match; only MATCH passes.
+constexpr uint8_t UNKNOWN = 0;
+constexpr uint8_t MATCH = 1;
+constexpr uint8_t MISS = 2;
+
+void compareColumn(const double* values, size_t n,
+                   FilterExpression::Cmp cmp, double rhs, uint8_t* out) {
+    using Cmp = FilterExpression::Cmp;
+    switch (cmp) {
+        case Cmp::LT: for (size_t i = 0; i < n; ++i) out[i] = MISS - (values[i] <  rhs); break;
+        case Cmp::LE: for (size_t i = 0; i < n; ++i) out[i] = MISS - (values[i] <= rhs); break;
+        case Cmp::GT: for (size_t i = 0; i < n; ++i) out[i] = MISS - (values[i] >  rhs); break;
+        case Cmp::GE: for (size_t i = 0; i < n; ++i) out[i] = MISS - (values[i] >= rhs); break;
+        case Cmp::EQ: for (size_t i = 0; i < n; ++i) out[i] = MISS - (values[i] == rhs); break;
+        case Cmp::NE: for (size_t i = 0; i < n; ++i) out[i] = MISS - (values[i] != rhs); break;
+    }
+}
+
+// PSS and USS are -1 until smaps_rollup has been read for the row.
+bool hasUnknownValues(FilterExpression::Column column) {
+    return column == FilterExpression::Column::PSS || column == FilterExpression::Column::USS;
+}
+
+void maskUnknown(const double* values, size_t n, uint8_t* out) {
+    for (size_t i = 0; i < n; ++i) out[i] *= values[i] >= 0.0;
+}
+
+// Name predicates run once per distinct name, then are gathered through
+// the rows' name ids.
+void gatherByName(const ProcessColumns& table, const uint8_t* perName, uint8_t* out) {
+    const uint32_t* ids = table.nameIds();
+    for (size_t i = 0, n = table.size(); i < n; ++i) out[i] = perName[ids[i]];
+}
+
+static_assert(static_cast<int>(FilterExpression::Column::PID) == ProcessColumns::PID &&
+              static_cast<int>(FilterExpression::Column::TIME) == ProcessColumns::TIME,
+              "numeric filter columns index ProcessColumns directly");
+
+void rangeColumn(const double* values, size_t n, double lo, double hi, uint8_t* out) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = MISS - ((values[i] >= lo) & (values[i] <= hi));
+    }
+}
+
+}
+
+// A lone word (or one quoted string) is what '/' always accepted: a name
+// substring. It is recognised before parsing so it is not an error.
+static bool bareWord(const std::string& source, std::string& word) {
+    size_t first = source.find_first_not_of(" \t");
+    if (first == std::string::npos) return false;
+    size_t last = source.find_last_not_of(" \t");
+    std::string trimmed = source.substr(first, last - first + 1);
+
+    char quote = trimmed.front();
+    if ((quote == '"' || quote == '\'') && trimmed.size() >= 2 && trimmed.back() == quote &&
+        trimmed.find(quote, 1) == trimmed.size() - 1) {
+        word = trimmed.substr(1, trimmed.size() - 2);
+        return true;
+    }
+    if (trimmed.find_first_of(" \t<>=!~()&|\"'") != std::string::npos) return false;
+    word = trimmed;
+    return true;
+}
+
+bool FilterExpression::compile(const std::string& source) {
+    program.clear();
+    nameHits.clear();
+    error.clear();
+    std::string word;
+    if (bareWord(source, word)) {
+        compileNameContains(word);
+        return true;
+    }
+    Parser parser(source, program);
+    if (!parser.parse(error)) {
+        program.clear();
+        return false;
+    }
+
+    return true;
+}
+
+void FilterExpression::compileNameContains(const std::string& needle) {
+    program.clear();
+    nameHits.clear();
+    Instr instr{Op::NAME_CONTAINS, Column::NAME};
+    instr.text = needle;
+    std::transform(instr.text.begin(), instr.text.end(), instr.text.begin(),
+                   [](unsigned char ch){ return std::tolower(ch); });
+    program.push_back(instr);
+}
+
+void FilterExpression::clear() {
+    program.clear();
+    nameHits.clear();
+    error.clear();
+}
+
+bool FilterExpression::empty() const {
+    return program.empty();
+}
+
+const std::string& FilterExpression::errorMessage() const {
+    return error;
+}
+
+void FilterExpression::evaluate(const ProcessColumns& table, std::vector<uint8_t>& mask) const {
+    const size_t n = table.size();
+    if (program.empty()) {
+        mask.assign(n, 1);
+        return;
+    }
+
+    if (scratch.size() < program.size()) scratch.resize(program.size());
+    if (nameHits.size() != program.size() || nameHitsGeneration != table.dictionaryGeneration()) {
+        nameHits.assign(program.size(), {});
+        nameHitsGeneration = table.dictionaryGeneration();
+    }
+    size_t depth = 0;
+
+    for (const auto& instr : program) {
+        switch (instr.op) {
+            // Raw pointers: a uint8_t store through a vector reference may
+            // alias the vector's own data pointer and blocks vectorization.
+            case Op::AND: {
+                const uint8_t* rhs = scratch[--depth].data();
+                uint8_t* lhs = scratch[depth - 1].data();
+                for (size_t i = 0; i < n; ++i) {
+                    lhs[i] = (lhs[i] & rhs[i] & MATCH) | ((lhs[i] | rhs[i]) & MISS);
+                }
+                break;
+            }
+            case Op::OR: {
+                const uint8_t* rhs = scratch[--depth].data();
+                uint8_t* lhs = scratch[depth - 1].data();
+                for (size_t i = 0; i < n; ++i) {
+                    lhs[i] = ((lhs[i] | rhs[i]) & MATCH) | (lhs[i] & rhs[i] & MISS);
+                }
+                break;
+            }
+            case Op::NOT: {
+                uint8_t* top = scratch[depth - 1].data();
+                for (size_t i = 0; i < n; ++i) {
+                    top[i] = static_cast<uint8_t>(((top[i] & MATCH) << 1) | (top[i] >> 1));
+                }
+                break;
+            }
+            case Op::CMP:
+            case Op::RANGE: {
+                const double* values =
+                    table.numeric(static_cast<ProcessColumns::Numeric>(instr.column));
+                auto& dst = scratch[depth++];
+                dst.resize(n);
+                if (instr.op == Op::CMP) compareColumn(values, n, instr.cmp, instr.lo, dst.data());
+                else                     rangeColumn(values, n, instr.lo, instr.hi, dst.data());
+                if (hasUnknownValues(instr.column)) maskUnknown(values, n, dst.data());
+                break;
+            }
+            case Op::NAME_CONTAINS:
+            case Op::NAME_EQUALS: {
+                auto& hits = nameHits[static_cast<size_t>(&instr - program.data())];
+                for (size_t id = hits.size(); id < table.dictionarySize(); ++id) {
+                    uint32_t key = static_cast<uint32_t>(id);
+                    bool hit = instr.op == Op::NAME_CONTAINS
+                        ? table.dictionaryFolded(key).find(instr.text) != std::string::npos
+                        : table.dictionaryName(key) == instr.text;
+                    hits.push_back(hit ? MATCH : MISS);
+                }
+                auto& dst = scratch[depth++];
+                dst.resize(n);
+                gatherByName(table, hits.data(), dst.data());
+                break;
+            }
+        }
+    }
+
+    mask.swap(scratch[0]);
+    uint8_t* out = mask.data();
+    for (size_t i = 0; i < n; ++i) out[i] &= MATCH;
+}
@@ -0,0 +1,54 @@
+#ifndef HTOP_CLONE_FILTER_EXPRESSION_HPP
+#define HTOP_CLONE_FILTER_EXPRESSION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "core/ProcessColumns.hpp"
+
+// Filter language for the '/' prompt, e.g.
+//   cpu > 50 && mem > 5 && name ~ "java"
+//   pid in 1000..2000 || !(uss < 10M)
+// The source is parsed once into a flat postfix program. Evaluation runs
+// each instruction as a tight loop over the table's column arrays (see
+// ProcessColumns), producing one byte mask per instruction, instead of
+// walking a tree for every row. Comparisons on a pss/uss value that was
+// never sampled are unknown: they never match, even under '!'.
+class FilterExpression {
+public:
+    enum class Column { PID, CPU, MEM, PSS, USS, TIME, NAME };
+    enum class Op { CMP, RANGE, NAME_CONTAINS, NAME_EQUALS, AND, OR, NOT };
+    enum class Cmp { LT, LE, GT, GE, EQ, NE };
+
+    struct Instr {
+        Op op;
+        Column column{Column::PID};
+        Cmp cmp{Cmp::EQ};
+        double lo{0.0};
+        double hi{0.0};
+        std::string text{};
+    };
+
+    bool compile(const std::string& source);
+    void compileNameContains(const std::string& needle);
+    void clear();
+
+    bool empty() const;
+    const std::string& errorMessage() const;
+
+    void evaluate(const ProcessColumns& table, std::vector<uint8_t>& mask) const;
+
+private:
+    std::vector<Instr> program;
+    std::string error;
+
+    mutable std::vector<std::vector<uint8_t>> scratch;
+
+    // Per name instruction, the result for each dictionary id seen so far;
+    // only names interned since the last evaluation are tested.
+    mutable std::vector<std::vector<uint8_t>> nameHits;
+    mutable uint64_t nameHitsGeneration{0};
+};
+
+#endif
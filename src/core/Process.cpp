@@ -10,37 +10,74 @@ Process::Process(int pid)
     : pid(pid), name(""), cpuUsage(0.0), memUsage(0.0), elapsedTime(0L)
 {
     updateStats();
+    readCgroup();
 }
 
-void Process::updateStats() {
-    const std::string statPath = "/proc/" + std::to_string(pid) + "/stat";
-    const std::string statmPath = "/proc/" + std::to_string(pid) + "/statm";
+Process::Process(const State& state)
+    : pid(state.pid), startTime(state.startTime), name(state.name), cpuUsage(state.cpuUsage), memUsage(state.memUsage),
+      elapsedTime(state.elapsedTime), cgroup(state.cgroup),
+      firstUpdate(false), pssKb(state.pssKb), ussKb(state.ussKb),
+      smapsSampledAt(state.smapsSampledAt)
+{
+}
 
-    std::ifstream statFile(statPath);
-    if (!statFile.is_open()) {
-        name = "";
-        cpuUsage = memUsage = 0.0;
-        elapsedTime = 0;
-        return;
+void Process::readCgroup() {
+    const std::string cgroupPath = "/proc/" + std::to_string(pid) + "/cgroup";
+
+    std::ifstream cgroupFile(cgroupPath);
+    if (!cgroupFile.is_open()) return;
+
+    std::string line;
+    while (std::getline(cgroupFile, line)) {
+        if (line.compare(0, 3, "0::") == 0) {
+            cgroup = line.substr(3);
+            break;
+        }
     }
+    cgroupFile.close();
+}
+
+// Splits /proc/<pid>/stat into its fields, indexed as in proc(5) minus one.
+// comm (field 2) may contain spaces and parentheses, so it is delimited by
+// the first '(' and the last ')' and returned without them.
+static bool readStatFields(int pid, std::vector<std::string>& fields) {
+    std::ifstream statFile("/proc/" + std::to_string(pid) + "/stat");
     std::string line;
-    std::getline(statFile, line);
-    statFile.close();
+    if (!statFile.is_open() || !std::getline(statFile, line)) return false;
 
-    std::istringstream iss(line);
-    std::vector<std::string> fields;
+    size_t open = line.find('(');
+    size_t close = line.rfind(')');
+    if (open == std::string::npos || close == std::string::npos || close < open) return false;
+
+    fields.clear();
+    fields.push_back(line.substr(0, open - 1));
+    fields.push_back(line.substr(open + 1, close - open - 1));
+    std::istringstream iss(line.substr(close + 1));
     std::string token;
     while (iss >> token) fields.push_back(token);
+    return fields.size() > 21;
+}
+
+bool Process::updateStats() {
+    const std::string statmPath = "/proc/" + std::to_string(pid) + "/statm";
+
+    std::vector<std::string> fields;
+    if (!readStatFields(pid, fields)) {
+        name = "";
+        cpuUsage = memUsage = 0.0;
+        elapsedTime = 0;
+        return true;
+    }
 
     long utime  = std::stol(fields[13]);
     long stime  = std::stol(fields[14]);
     long startT = std::stol(fields[21]);
     long totalJiffies = utime + stime;
 
-    std::string comm = fields[1];
-    if (comm.front()=='(' && comm.back()==')')
-        comm = comm.substr(1, comm.size()-2);
-    name = comm;
+    if (startTime >= 0 && startT != startTime) return false;
+    startTime = startT;
+
+    name = fields[1];
 
     std::ifstream upFile("/proc/uptime");
     double sysUptime = 0.0;
@@ -88,6 +125,43 @@ void Process::updateStats() {
     memUsage = (memTotalBytes > 0)
         ? 100.0 * (rssBytes / static_cast<double>(memTotalBytes))
         : 0.0;
+    return true;
+}
+
+bool Process::isStillRunning() const {
+    std::vector<std::string> fields;
+    if (startTime < 0 || !readStatFields(pid, fields)) return false;
+    return fields[1] == name && std::stol(fields[21]) == startTime;
+}
+
+bool Process::sampleSmapsRollup() {
+    const std::string rollupPath = "/proc/" + std::to_string(pid) + "/smaps_rollup";
+
+    std::ifstream rollupFile(rollupPath);
+    if (!rollupFile.is_open()) return false;
+
+    long pss = -1, privateKb = 0;
+    std::string label;
+    long value = 0;
+    std::string unit;
+    std::string header;
+    std::getline(rollupFile, header);
+    while (rollupFile >> label >> value >> unit) {
+        if (label == "Pss:") {
+            pss = value;
+        } else if (label == "Private_Clean:" ||
+                   label == "Private_Dirty:" ||
+                   label == "Private_Hugetlb:") {
+            privateKb += value;
+        }
+    }
+    rollupFile.close();
+
+    if (pss < 0) return false;
+    pssKb = pss;
+    ussKb = privateKb;
+    smapsSampledAt = std::chrono::steady_clock::now();
+    return true;
 }
 
 std::string Process::formatForDisplay() const {
@@ -96,12 +170,28 @@ std::string Process::formatForDisplay() const {
         << "\t" << name
         << "\tCPU:"  << (cpuUsage  < 0.0 ? 0.0 : cpuUsage ) << "%"
         << "\tMEM:"  << (memUsage  < 0.0 ? 0.0 : memUsage ) << "%"
+        << "\tPSS:"  << pssKb << "kB"
+        << "\tUSS:"  << ussKb << "kB"
         << "\tTIME:" << elapsedTime << "s";
     return oss.str();
 }
 
 int Process::getPid()           const { return pid; }
+long Process::getStartTime()    const { return startTime; }
 const std::string& Process::getName() const { return name; }
+const std::string& Process::getCgroup() const { return cgroup; }
 double Process::getCpuUsage()   const { return cpuUsage; }
 double Process::getMemUsage()   const { return memUsage; }
 long Process::getElapsedTime()  const { return elapsedTime; }
+long Process::getPssKb()        const { return pssKb; }
+long Process::getUssKb()        const { return ussKb; }
+
+double Process::getSmapsAge() const {
+    if (pssKb < 0) return -1.0;
+    std::chrono::duration<double> age = std::chrono::steady_clock::now() - smapsSampledAt;
+    return age.count();
+}
+
+std::chrono::steady_clock::time_point Process::getSmapsSampledAt() const {
+    return smapsSampledAt;
+}
@@ -2,30 +2,66 @@
 #define HTOP_CLONE_PROCESS_HPP
 
 #include <string>
+#include <chrono>
 
 class Process {
 public:
+    // Already-collected values, used to rebuild rows from a published snapshot.
+    struct State {
+        int pid{0};
+        long startTime{-1};
+        std::string name;
+        std::string cgroup;
+        double cpuUsage{0.0};
+        double memUsage{0.0};
+        long elapsedTime{0};
+        long pssKb{-1};
+        long ussKb{-1};
+        std::chrono::steady_clock::time_point smapsSampledAt{};
+    };
+
     explicit Process(int pid);
+    explicit Process(const State& state);
 
-    void updateStats();
+    // Returns false, leaving the row untouched, when the pid now names a
+    // different process (its start time no longer matches).
+    bool updateStats();
+    bool sampleSmapsRollup();
+    // True while the pid still names this process (same comm and start
+    // time); checked before signalling a row that may be stale.
+    bool isStillRunning() const;
     std::string formatForDisplay() const;
 
     int getPid() const;
+    long getStartTime() const;
     const std::string& getName() const;
+    const std::string& getCgroup() const;
     double getCpuUsage() const;
     double getMemUsage() const;
     long getElapsedTime() const;
+    long getPssKb() const;
+    long getUssKb() const;
+    double getSmapsAge() const;
+    std::chrono::steady_clock::time_point getSmapsSampledAt() const;
 
 private:
     int pid;
+    long startTime{-1};
     std::string name;
     double cpuUsage;
     double memUsage;
     long elapsedTime;
+    std::string cgroup;
 
     long prevJiffies{0};
     double prevSeconds{0.0};
     bool firstUpdate{true};
+
+    long pssKb{-1};
+    long ussKb{-1};
+    std::chrono::steady_clock::time_point smapsSampledAt{};
+
+    void readCgroup();
 };
 
 #endif
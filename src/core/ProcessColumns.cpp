@@ -0,0 +1,81 @@
+#include "core/ProcessColumns.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+uint64_t ProcessColumns::nextGeneration() {
+    static uint64_t counter = 0;
+    return ++counter;
+}
+
+uint32_t ProcessColumns::intern(const std::string& name) {
+    auto it = idOf.find(name);
+    if (it != idOf.end()) return it->second;
+
+    uint32_t id = static_cast<uint32_t>(dictionary.size());
+    idOf.emplace(name, id);
+    dictionary.push_back(name);
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char ch){ return std::tolower(ch); });
+    folded.push_back(std::move(lower));
+    return id;
+}
+
+void ProcessColumns::assign(const std::vector<Process>& rows) {
+    count = rows.size();
+    for (auto& column : values) column.resize(count);
+    ids.resize(count);
+
+    if (dictionary.size() > 2 * count + 1024) {
+        idOf.clear();
+        dictionary.clear();
+        folded.clear();
+        generation = nextGeneration();
+    }
+
+    double* pid = values[PID].data();
+    double* cpu = values[CPU].data();
+    double* mem = values[MEM].data();
+    double* pss = values[PSS].data();
+    double* uss = values[USS].data();
+    double* time = values[TIME].data();
+    for (size_t i = 0; i < count; ++i) {
+        const Process& p = rows[i];
+        pid[i] = p.getPid();
+        cpu[i] = p.getCpuUsage();
+        mem[i] = p.getMemUsage();
+        pss[i] = static_cast<double>(p.getPssKb());
+        uss[i] = static_cast<double>(p.getUssKb());
+        time[i] = static_cast<double>(p.getElapsedTime());
+        ids[i] = intern(p.getName());
+    }
+}
+
+size_t ProcessColumns::size() const {
+    return count;
+}
+
+const double* ProcessColumns::numeric(Numeric column) const {
+    return values[column].data();
+}
+
+const uint32_t* ProcessColumns::nameIds() const {
+    return ids.data();
+}
+
+uint64_t ProcessColumns::dictionaryGeneration() const {
+    return generation;
+}
+
+size_t ProcessColumns::dictionarySize() const {
+    return dictionary.size();
+}
+
+const std::string& ProcessColumns::dictionaryName(uint32_t id) const {
+    return dictionary[id];
+}
+
+const std::string& ProcessColumns::dictionaryFolded(uint32_t id) const {
+    return folded[id];
+}
@@ -0,0 +1,52 @@
+#ifndef HTOP_CLONE_PROCESS_COLUMNS_HPP
+#define HTOP_CLONE_PROCESS_COLUMNS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "core/Process.hpp"
+
+// The process table's filterable fields stored column by column, parallel
+// to the row vector they were built from. Rebuilt once per refresh so that
+// every filter evaluation scans contiguous arrays instead of striding over
+// whole Process objects.
+//
+// Names are dictionary-encoded: each row holds the id of its name, so a
+// name predicate is evaluated once per distinct name and then gathered.
+class ProcessColumns {
+public:
+    enum Numeric { PID, CPU, MEM, PSS, USS, TIME, NUMERIC_COUNT };
+
+    void assign(const std::vector<Process>& rows);
+
+    size_t size() const;
+    const double* numeric(Numeric column) const;
+    const uint32_t* nameIds() const;
+
+    // Ids stay valid, and the dictionary only grows, until the generation
+    // changes, so per-name results may be cached against it.
+    uint64_t dictionaryGeneration() const;
+    size_t dictionarySize() const;
+    const std::string& dictionaryName(uint32_t id) const;
+    // Lowercased copy of dictionaryName(id), for case-insensitive matching.
+    const std::string& dictionaryFolded(uint32_t id) const;
+
+private:
+    size_t count{0};
+    std::vector<double> values[NUMERIC_COUNT];
+    std::vector<uint32_t> ids;
+
+    // Kept across refreshes so steady-state names are not re-folded; reset
+    // once exited names make it much larger than the live table.
+    std::unordered_map<std::string, uint32_t> idOf;
+    std::vector<std::string> dictionary;
+    std::vector<std::string> folded;
+    uint64_t generation{nextGeneration()};
+
+    static uint64_t nextGeneration();
+    uint32_t intern(const std::string& name);
+};
+
+#endif
@@ -0,0 +1,94 @@
+#include "core/ProcessHistory.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// Decades between MEM_FLOOR_PERCENT and 100%.
+static constexpr double MEM_DECADES = 5.0;
+
+uint8_t ProcessHistory::quantizeCpu(double percent) {
+    double clamped = std::clamp(percent, 0.0, 100.0);
+    return static_cast<uint8_t>(clamped * 2.55 + 0.5);
+}
+
+uint8_t ProcessHistory::quantizeMem(double percent) {
+    if (percent <= MEM_FLOOR_PERCENT) return 0;
+    double decades = std::log10(std::min(percent, 100.0) / MEM_FLOOR_PERCENT);
+    return static_cast<uint8_t>(decades * (255.0 / MEM_DECADES) + 0.5);
+}
+
+double ProcessHistory::toPercent(Metric metric, uint8_t sample) {
+    if (metric == Metric::CPU) return sample / 2.55;
+    if (sample == 0) return 0.0;
+    return MEM_FLOOR_PERCENT * std::pow(10.0, sample * (MEM_DECADES / 255.0));
+}
+
+uint32_t ProcessHistory::acquireSlot(int pid) {
+    auto it = slotOf.find(pid);
+    if (it != slotOf.end()) return it->second;
+
+    uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(heads.size());
+        heads.push_back(0);
+        counts.push_back(0);
+        if (pool.size() < heads.size() * SLOT_BYTES) {
+            pool.resize(std::max(pool.size() * 2, heads.size() * SLOT_BYTES));
+        }
+    }
+    heads[slot] = 0;
+    counts[slot] = 0;
+    slotOf.emplace(pid, slot);
+    return slot;
+}
+
+void ProcessHistory::record(int pid, double cpuPercent, double memPercent) {
+    uint32_t slot = acquireSlot(pid);
+    uint8_t* base = pool.data() + slot * SLOT_BYTES;
+    uint8_t head = heads[slot];
+
+    base[head] = quantizeCpu(cpuPercent);
+    base[CAPACITY + head] = quantizeMem(memPercent);
+
+    heads[slot] = static_cast<uint8_t>((head + 1) % CAPACITY);
+    if (counts[slot] < CAPACITY) ++counts[slot];
+}
+
+void ProcessHistory::release(int pid) {
+    auto it = slotOf.find(pid);
+    if (it == slotOf.end()) return;
+    freeSlots.push_back(it->second);
+    slotOf.erase(it);
+}
+
+size_t ProcessHistory::copySamples(int pid, Metric metric, uint8_t* out, size_t maxSamples) const {
+    auto it = slotOf.find(pid);
+    if (it == slotOf.end()) return 0;
+
+    uint32_t slot = it->second;
+    const uint8_t* ring = pool.data() + slot * SLOT_BYTES
+                        + (metric == Metric::MEM ? CAPACITY : 0);
+    size_t n = std::min<size_t>(counts[slot], maxSamples);
+    size_t start = (heads[slot] + CAPACITY - n) % CAPACITY;
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = ring[(start + i) % CAPACITY];
+    }
+    return n;
+}
+
+size_t ProcessHistory::trackedCount() const {
+    return slotOf.size();
+}
+
+size_t ProcessHistory::bytesReserved() const {
+    // Node size approximates a libstdc++ hash node: next pointer + key/value + cached hash.
+    constexpr size_t nodeBytes = sizeof(void*) + sizeof(std::pair<const int, uint32_t>) + sizeof(size_t);
+    return pool.capacity()
+         + heads.capacity() + counts.capacity()
+         + freeSlots.capacity() * sizeof(uint32_t)
+         + slotOf.bucket_count() * sizeof(void*)
+         + slotOf.size() * nodeBytes;
+}
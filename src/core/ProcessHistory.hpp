@@ -0,0 +1,47 @@
+#ifndef HTOP_CLONE_PROCESS_HISTORY_HPP
+#define HTOP_CLONE_PROCESS_HISTORY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Fixed-size CPU/MEM sample rings for every tracked process, stored in a
+// single pooled buffer. Slots are recycled when a process exits, so the
+// footprint only grows with the peak number of live processes.
+class ProcessHistory {
+public:
+    static constexpr size_t CAPACITY = 120;
+
+    enum class Metric { CPU = 0, MEM = 1 };
+
+    void record(int pid, double cpuPercent, double memPercent);
+    void release(int pid);
+
+    size_t copySamples(int pid, Metric metric, uint8_t* out, size_t maxSamples) const;
+
+    // CPU samples are linear over 0-100%. MEM samples are logarithmic over
+    // MEM_FLOOR_PERCENT-100%, one decade per 51 steps: most processes hold
+    // well under 1% of RAM and would all quantize to zero on a linear scale.
+    static double toPercent(Metric metric, uint8_t sample);
+
+    static constexpr double MEM_FLOOR_PERCENT = 0.001;
+
+    size_t trackedCount() const;
+    size_t bytesReserved() const;
+
+private:
+    static constexpr size_t SLOT_BYTES = 2 * CAPACITY;
+
+    std::vector<uint8_t> pool;
+    std::vector<uint8_t> heads;
+    std::vector<uint8_t> counts;
+    std::vector<uint32_t> freeSlots;
+    std::unordered_map<int, uint32_t> slotOf;
+
+    uint32_t acquireSlot(int pid);
+    static uint8_t quantizeCpu(double percent);
+    static uint8_t quantizeMem(double percent);
+};
+
+#endif
@@ -3,20 +3,117 @@
 #include <dirent.h>
 #include <algorithm>
 #include <cctype>
+#include <unordered_map>
 
 ProcessManager::ProcessManager() {
     refresh();
 }
 
+ProcessManager::ProcessManager(Snapshot::Reader* source)
+    : source(source)
+{
+    refresh();
+}
+
+void ProcessManager::setPublisher(Snapshot::Publisher* pub) {
+    publisher = pub;
+}
+
+bool ProcessManager::isAttached() const {
+    return source != nullptr;
+}
+
+double ProcessManager::getSnapshotAge() const {
+    return source ? source->snapshotAge() : -1.0;
+}
+
 void ProcessManager::attach(IObserver* obs) {
     observers.push_back(obs);
 }
 
 void ProcessManager::refresh() {
-    processes.clear();
+    addedPids.clear();
+    exitedPids.clear();
+    changedRows.clear();
+
+    // Without new data (an unchanged snapshot, or /proc unreadable) there is
+    // nothing to record or diff; observers still get the empty delta.
+    bool collected = source ? collectFromSnapshot() : collectFromProc();
+    if (collected) {
+        // A headless collector only feeds the segment: the column store,
+        // deltas and history are there for observers, and attached viewers
+        // rebuild their own from the snapshot.
+        if (!publisher || !observers.empty()) {
+            columns.assign(processes);
+            tracker.compute(columns, origin, addedPids, changedRows);
+
+            for (const auto& p : processes) {
+                history.record(p.getPid(), p.getCpuUsage(), p.getMemUsage());
+            }
+        }
+
+        if (publisher) {
+            publisher->publish(processes, cgroups.getGroups(), system);
+        }
+    }
+
+    ProcessDelta delta{addedPids, exitedPids, changedRows};
+    for (auto* obs : observers) {
+        obs->onUpdate(delta);
+    }
+}
+
+bool ProcessManager::collectFromSnapshot() {
+    std::vector<Process> incoming;
+    std::vector<CgroupStats> groups;
+    if (source->read(incoming, groups, system) != Snapshot::ReadResult::UPDATED) return false;
+
+    std::unordered_map<int, size_t> known;
+    known.reserve(processes.size());
+    for (size_t i = 0; i < processes.size(); ++i) {
+        known.emplace(processes[i].getPid(), i);
+    }
+
+    origin.clear();
+    origin.reserve(incoming.size());
+    std::vector<bool> seen(processes.size(), false);
+    for (const auto& p : incoming) {
+        auto it = known.find(p.getPid());
+        if (it != known.end() &&
+            processes[it->second].getStartTime() == p.getStartTime()) {
+            seen[it->second] = true;
+            origin.push_back(static_cast<long>(it->second));
+        } else {
+            origin.push_back(-1);
+        }
+    }
+    for (size_t i = 0; i < seen.size(); ++i) {
+        if (!seen[i]) {
+            exitedPids.push_back(processes[i].getPid());
+            history.release(processes[i].getPid());
+        }
+    }
+
+    processes = std::move(incoming);
+    cgroups.replaceAll(std::move(groups));
+    return true;
+}
+
+bool ProcessManager::collectFromProc() {
+    std::unordered_map<int, size_t> known;
+    known.reserve(processes.size());
+    for (size_t i = 0; i < processes.size(); ++i) {
+        known.emplace(processes[i].getPid(), i);
+    }
 
     DIR* procDir = opendir("/proc");
-    if (!procDir) return;
+    if (!procDir) return false;
+
+    std::vector<Process> current;
+    current.reserve(processes.size());
+    origin.clear();
+    origin.reserve(processes.size());
+    std::vector<bool> seen(processes.size(), false);
 
     struct dirent* entry;
     while ((entry = readdir(procDir)) != nullptr) {
@@ -26,13 +123,67 @@ void ProcessManager::refresh() {
             std::all_of(name.begin(), name.end(),
                         [](char c){ return std::isdigit(c); })) {
             int pid = std::stoi(name);
-            processes.emplace_back(pid);
+            // A pid whose start time changed was reused by a new process:
+            // the old row is left unseen (exited) and a fresh one is built,
+            // so no cached sample or baseline carries over.
+            auto it = known.find(pid);
+            double oldCpu = 0.0, oldMem = 0.0;
+            if (it != known.end()) {
+                oldCpu = processes[it->second].getCpuUsage();
+                oldMem = processes[it->second].getMemUsage();
+            }
+            if (it != known.end() && processes[it->second].updateStats()) {
+                seen[it->second] = true;
+                origin.push_back(static_cast<long>(it->second));
+                current.push_back(std::move(processes[it->second]));
+                cgroups.update(current.back(), oldCpu, oldMem);
+            } else {
+                origin.push_back(-1);
+                current.emplace_back(pid);
+                cgroups.add(current.back());
+            }
         }
     }
     closedir(procDir);
 
-    for (auto* obs : observers) {
-        obs->onUpdate();
+    for (size_t i = 0; i < seen.size(); ++i) {
+        if (!seen[i]) {
+            exitedPids.push_back(processes[i].getPid());
+            history.release(processes[i].getPid());
+            cgroups.remove(processes[i]);
+        }
+    }
+    cgroups.refreshSysfs();
+
+    processes = std::move(current);
+    sampleSmaps();
+    system = systemSampler.sample();
+    return true;
+}
+
+void ProcessManager::sampleSmaps() {
+    if (processes.empty()) return;
+
+    std::vector<size_t> order(processes.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(),
+              [this](size_t a, size_t b){
+                  return processes[a].getPid() < processes[b].getPid();
+              });
+
+    auto start = std::lower_bound(order.begin(), order.end(), smapsCursorPid + 1,
+                                  [this](size_t idx, int pid){
+                                      return processes[idx].getPid() < pid;
+                                  });
+    size_t pos = static_cast<size_t>(start - order.begin());
+
+    const auto deadline = std::chrono::steady_clock::now() + SMAPS_TICK_BUDGET;
+    for (size_t visited = 0; visited < order.size(); ++visited) {
+        if (pos == order.size()) pos = 0;
+        Process& p = processes[order[pos++]];
+        p.sampleSmapsRollup();
+        smapsCursorPid = p.getPid();
+        if (std::chrono::steady_clock::now() >= deadline) break;
     }
 }
 
@@ -40,23 +191,18 @@ const std::vector<Process>& ProcessManager::getProcesses() const {
     return processes;
 }
 
-void ProcessManager::sortByPid() {
-    std::sort(processes.begin(), processes.end(),
-              [](const Process& a, const Process& b){
-                  return a.getPid() < b.getPid();
-              });
+const ProcessColumns& ProcessManager::getColumns() const {
+    return columns;
 }
 
-void ProcessManager::sortByCpu() {
-    std::sort(processes.begin(), processes.end(),
-              [](const Process& a, const Process& b){
-                  return a.getCpuUsage() > b.getCpuUsage();
-              });
+const ProcessHistory& ProcessManager::getHistory() const {
+    return history;
 }
 
-void ProcessManager::sortByMem() {
-    std::sort(processes.begin(), processes.end(),
-              [](const Process& a, const Process& b){
-                  return a.getMemUsage() > b.getMemUsage();
-              });
+const CgroupManager& ProcessManager::getCgroups() const {
+    return cgroups;
+}
+
+const SystemStats& ProcessManager::getSystemStats() const {
+    return system;
 }
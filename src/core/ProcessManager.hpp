@@ -2,26 +2,64 @@
 #define HTOP_CLONE_PROCESS_MANAGER_HPP
 
 #include <vector>
+#include <chrono>
 #include "core/Process.hpp"
+#include "core/ProcessColumns.hpp"
+#include "core/ProcessHistory.hpp"
+#include "core/CgroupManager.hpp"
+#include "core/DeltaTracker.hpp"
+#include "core/SnapshotChannel.hpp"
+#include "core/SystemStats.hpp"
 #include "patterns/Observer.hpp"
 
 class ProcessManager {
 public:
     ProcessManager();
+    explicit ProcessManager(Snapshot::Reader* source);
 
     void refresh();
 
-    const std::vector<Process>& getProcesses() const;
+    void setPublisher(Snapshot::Publisher* publisher);
+    bool isAttached() const;
+    double getSnapshotAge() const;
 
-    void sortByPid();
-    void sortByCpu();
-    void sortByMem();
+    const std::vector<Process>& getProcesses() const;
+    const ProcessColumns& getColumns() const;
+    const ProcessHistory& getHistory() const;
+    const CgroupManager& getCgroups() const;
+    const SystemStats& getSystemStats() const;
 
     void attach(IObserver* obs);
 
 private:
+    // smaps_rollup walks every VMA of the target, so only a slice of the
+    // table is resampled per tick; the rest keep their last cached values.
+    static constexpr std::chrono::milliseconds SMAPS_TICK_BUDGET{15};
+
     std::vector<Process> processes;
+    ProcessColumns columns;
     std::vector<IObserver*> observers;
+    ProcessHistory history;
+    CgroupManager cgroups;
+    SystemStats system;
+    SystemStatsSampler systemSampler;
+
+    Snapshot::Reader* source{nullptr};
+    Snapshot::Publisher* publisher{nullptr};
+
+    int smapsCursorPid{0};
+
+    // Delta buffers, reused across refreshes. origin maps each row to its
+    // index in the previous table (-1 for new rows).
+    DeltaTracker tracker;
+    std::vector<long> origin;
+    std::vector<int> addedPids;
+    std::vector<int> exitedPids;
+    std::vector<ProcessChange> changedRows;
+
+    bool collectFromProc();
+    bool collectFromSnapshot();
+    void sampleSmaps();
 };
 
 #endif
@@ -0,0 +1,355 @@
+#include "core/SnapshotChannel.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sched.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace Snapshot {
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "the seqlock counter must be lock-free to live in shared memory");
+
+static size_t segmentSize() {
+    return sizeof(Header)
+         + sizeof(ProcessRecord) * PROCESS_CAPACITY
+         + sizeof(GroupRecord) * GROUP_CAPACITY;
+}
+
+static ProcessRecord* processRecords(void* base) {
+    return reinterpret_cast<ProcessRecord*>(static_cast<char*>(base) + sizeof(Header));
+}
+
+static const ProcessRecord* processRecords(const void* base) {
+    return reinterpret_cast<const ProcessRecord*>(static_cast<const char*>(base) + sizeof(Header));
+}
+
+static GroupRecord* groupRecords(void* base) {
+    return reinterpret_cast<GroupRecord*>(processRecords(base) + PROCESS_CAPACITY);
+}
+
+static const GroupRecord* groupRecords(const void* base) {
+    return reinterpret_cast<const GroupRecord*>(processRecords(base) + PROCESS_CAPACITY);
+}
+
+static int64_t steadyNanos(std::chrono::steady_clock::time_point t) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+static void copyString(char* dst, size_t len, const std::string& src) {
+    size_t n = std::min(len - 1, src.size());
+    std::memcpy(dst, src.data(), n);
+    dst[n] = '\0';
+}
+
+// Another local user could pre-create the segment name and feed viewers a
+// forged process table (whose pids they then signal), so a segment is only
+// trusted when root or the current user owns it and nobody else can write it.
+static bool segmentTrusted(int fd, const std::string& name, std::string& error) {
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        error = "fstat(" + name + "): " + std::strerror(errno);
+        return false;
+    }
+    if (st.st_uid != 0 && st.st_uid != getuid()) {
+        error = name + ": segment is owned by uid " + std::to_string(st.st_uid)
+              + "; refusing to use it";
+        return false;
+    }
+    if (st.st_mode & (S_IWGRP | S_IWOTH)) {
+        error = name + ": segment is writable by group or others; refusing to use it";
+        return false;
+    }
+    return true;
+}
+
+Publisher::Publisher(std::string name)
+    : name(std::move(name)) {}
+
+Publisher::~Publisher() {
+    if (mapping) {
+        munmap(mapping, mappingSize);
+        shm_unlink(name.c_str());
+    }
+    if (fd >= 0) close(fd);
+}
+
+bool Publisher::open() {
+    fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd < 0) {
+        error = "shm_open(" + name + "): " + std::strerror(errno);
+        return false;
+    }
+    if (!segmentTrusted(fd, name, error)) {
+        close(fd);
+        fd = -1;
+        return false;
+    }
+    // The lock is held for the publisher's lifetime, so a second collector
+    // fails here instead of interleaving writes with the first one.
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        error = "another collector is already publishing to " + name;
+        close(fd);
+        fd = -1;
+        return false;
+    }
+
+    mappingSize = segmentSize();
+    if (ftruncate(fd, static_cast<off_t>(mappingSize)) != 0) {
+        error = "ftruncate(" + name + "): " + std::strerror(errno);
+        return false;
+    }
+    mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        error = "mmap(" + name + "): " + std::strerror(errno);
+        return false;
+    }
+
+    Header* hdr = new (mapping) Header;
+    hdr->magic = MAGIC;
+    hdr->version = VERSION;
+    hdr->processRecordSize = sizeof(ProcessRecord);
+    hdr->groupRecordSize = sizeof(GroupRecord);
+    hdr->processCapacity = PROCESS_CAPACITY;
+    hdr->groupCapacity = GROUP_CAPACITY;
+    hdr->processCount = 0;
+    hdr->groupCount = 0;
+    hdr->publishedAtNs = 0;
+    hdr->sequence.store(0, std::memory_order_release);
+    return true;
+}
+
+void Publisher::publish(const std::vector<Process>& processes,
+                        const std::vector<CgroupStats>& groups,
+                        const SystemStats& system) {
+    if (!mapping) return;
+
+    Header* hdr = static_cast<Header*>(mapping);
+    ProcessRecord* procOut = processRecords(mapping);
+    GroupRecord* groupOut = groupRecords(mapping);
+
+    uint32_t groupCount = static_cast<uint32_t>(std::min<size_t>(groups.size(), GROUP_CAPACITY));
+    uint32_t processCount = static_cast<uint32_t>(std::min<size_t>(processes.size(), PROCESS_CAPACITY));
+
+    std::unordered_map<std::string, uint32_t> groupIndex;
+    groupIndex.reserve(groupCount);
+    for (uint32_t i = 0; i < groupCount; ++i) {
+        groupIndex.emplace(groups[i].path, i);
+    }
+
+    uint64_t seq = hdr->sequence.load(std::memory_order_relaxed);
+    hdr->sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (uint32_t i = 0; i < groupCount; ++i) {
+        const CgroupStats& g = groups[i];
+        GroupRecord& r = groupOut[i];
+        copyString(r.path, sizeof(r.path), g.path);
+        r.procCount = g.procCount;
+        r.cpuUsage = g.cpuUsage;
+        r.memUsage = g.memUsage;
+        r.cgroupCpu = g.cgroupCpu;
+        r.memoryCurrentKb = g.memoryCurrentKb;
+        r.cpuPressure = g.cpuPressure;
+        r.memPressure = g.memPressure;
+    }
+
+    for (uint32_t i = 0; i < processCount; ++i) {
+        const Process& p = processes[i];
+        ProcessRecord& r = procOut[i];
+        auto it = groupIndex.find(p.getCgroup());
+        r.pid = p.getPid();
+        r.startTime = p.getStartTime();
+        r.group = it != groupIndex.end() ? it->second : UINT32_MAX;
+        copyString(r.name, sizeof(r.name), p.getName());
+        r.cpuUsage = p.getCpuUsage();
+        r.memUsage = p.getMemUsage();
+        r.elapsedTime = p.getElapsedTime();
+        r.pssKb = p.getPssKb();
+        r.ussKb = p.getUssKb();
+        r.smapsSampledAtNs = steadyNanos(p.getSmapsSampledAt());
+    }
+
+    hdr->processCount = processCount;
+    hdr->groupCount = groupCount;
+    hdr->publishedAtNs = steadyNanos(std::chrono::steady_clock::now());
+    hdr->systemCpuUsage = system.cpuUsage;
+    hdr->systemMemUsage = system.memUsage;
+
+    hdr->sequence.store(seq + 2, std::memory_order_release);
+}
+
+const std::string& Publisher::errorMessage() const {
+    return error;
+}
+
+Reader::Reader(std::string name)
+    : name(std::move(name)) {}
+
+Reader::~Reader() {
+    if (mapping) munmap(const_cast<void*>(mapping), mappingSize);
+}
+
+bool Reader::open() {
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        error = "shm_open(" + name + "): " + std::strerror(errno)
+              + " (is a --daemon collector running?)";
+        return false;
+    }
+
+    if (!segmentTrusted(fd, name, error)) {
+        close(fd);
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+        error = name + ": segment is not initialised";
+        close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void* m = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (m == MAP_FAILED) {
+        error = "mmap(" + name + "): " + std::strerror(errno);
+        return false;
+    }
+
+    const Header* hdr = static_cast<const Header*>(m);
+    if (hdr->magic != MAGIC || hdr->version != VERSION ||
+        hdr->processRecordSize != sizeof(ProcessRecord) ||
+        hdr->groupRecordSize != sizeof(GroupRecord) ||
+        hdr->processCapacity != PROCESS_CAPACITY ||
+        hdr->groupCapacity != GROUP_CAPACITY ||
+        size < segmentSize()) {
+        error = name + ": segment was written by an incompatible collector";
+        munmap(m, size);
+        return false;
+    }
+
+    // Only replace a previous mapping once the new one has been validated.
+    if (mapping) munmap(const_cast<void*>(mapping), mappingSize);
+    mapping = m;
+    mappingSize = size;
+    device = st.st_dev;
+    inode = st.st_ino;
+    lastSequence = 0;
+    return true;
+}
+
+bool Reader::segmentReplaced() const {
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) return false;
+    struct stat st;
+    bool replaced = fstat(fd, &st) == 0 && (st.st_dev != device || st.st_ino != inode);
+    close(fd);
+    return replaced;
+}
+
+ReadResult Reader::read(std::vector<Process>& processes, std::vector<CgroupStats>& groups,
+                        SystemStats& system) {
+    if (!mapping) return ReadResult::FAILED;
+
+    auto now = std::chrono::steady_clock::now();
+    double age = snapshotAge();
+    if ((age < 0.0 || age > REOPEN_AFTER.count()) && now - lastReopenCheck >= REOPEN_AFTER) {
+        lastReopenCheck = now;
+        // On failure (e.g. the new collector has not initialised its
+        // header yet) the old mapping is kept and the check repeats later.
+        if (segmentReplaced()) open();
+    }
+
+    const Header* hdr = static_cast<const Header*>(mapping);
+    const ProcessRecord* procIn = processRecords(mapping);
+    const GroupRecord* groupIn = groupRecords(mapping);
+
+    for (int attempt = 0; attempt < MAX_ATTEMPTS; ++attempt) {
+        uint64_t before = hdr->sequence.load(std::memory_order_acquire);
+        if (before == 0) {
+            error = "no snapshot published yet";
+            return ReadResult::FAILED;
+        }
+        if (before & 1) {
+            sched_yield();
+            continue;
+        }
+        if (before == lastSequence) return ReadResult::UNCHANGED;
+
+        uint32_t processCount = std::min(hdr->processCount, PROCESS_CAPACITY);
+        uint32_t groupCount = std::min(hdr->groupCount, GROUP_CAPACITY);
+        int64_t publishedAt = hdr->publishedAtNs;
+        SystemStats totals{hdr->systemCpuUsage, hdr->systemMemUsage};
+        processBuf.resize(processCount);
+        groupBuf.resize(groupCount);
+        std::memcpy(processBuf.data(), procIn, processCount * sizeof(ProcessRecord));
+        std::memcpy(groupBuf.data(), groupIn, groupCount * sizeof(GroupRecord));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (hdr->sequence.load(std::memory_order_relaxed) != before) continue;
+
+        lastPublishedAtNs = publishedAt;
+        lastSequence = before;
+        system = totals;
+
+        groups.clear();
+        groups.reserve(groupBuf.size());
+        for (auto& r : groupBuf) {
+            r.path[sizeof(r.path) - 1] = '\0';
+            CgroupStats g;
+            g.path = r.path;
+            g.procCount = r.procCount;
+            g.cpuUsage = r.cpuUsage;
+            g.memUsage = r.memUsage;
+            g.cgroupCpu = r.cgroupCpu;
+            g.memoryCurrentKb = r.memoryCurrentKb;
+            g.cpuPressure = r.cpuPressure;
+            g.memPressure = r.memPressure;
+            groups.push_back(std::move(g));
+        }
+
+        processes.clear();
+        processes.reserve(processBuf.size());
+        for (auto& r : processBuf) {
+            r.name[sizeof(r.name) - 1] = '\0';
+            Process::State s;
+            s.pid = r.pid;
+            s.startTime = static_cast<long>(r.startTime);
+            s.name = r.name;
+            if (r.group < groups.size()) s.cgroup = groups[r.group].path;
+            s.cpuUsage = r.cpuUsage;
+            s.memUsage = r.memUsage;
+            s.elapsedTime = static_cast<long>(r.elapsedTime);
+            s.pssKb = static_cast<long>(r.pssKb);
+            s.ussKb = static_cast<long>(r.ussKb);
+            s.smapsSampledAt = std::chrono::steady_clock::time_point(
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::nanoseconds(r.smapsSampledAtNs)));
+            processes.emplace_back(s);
+        }
+        return ReadResult::UPDATED;
+    }
+
+    error = "snapshot kept changing while reading";
+    return ReadResult::FAILED;
+}
+
+double Reader::snapshotAge() const {
+    if (lastPublishedAtNs < 0) return -1.0;
+    int64_t now = steadyNanos(std::chrono::steady_clock::now());
+    return (now - lastPublishedAtNs) / 1e9;
+}
+
+const std::string& Reader::errorMessage() const {
+    return error;
+}
+
+}
@@ -0,0 +1,138 @@
+#ifndef HTOP_CLONE_SNAPSHOT_CHANNEL_HPP
+#define HTOP_CLONE_SNAPSHOT_CHANNEL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include "core/Process.hpp"
+#include "core/CgroupManager.hpp"
+#include "core/SystemStats.hpp"
+
+// Process table snapshots shared through a POSIX shared-memory segment.
+// One collector (--daemon) publishes; any number of viewers (--attach)
+// map the segment read-only. The segment is guarded by a seqlock: the
+// writer makes the sequence odd while it copies, and readers retry when
+// they observe an odd or changed sequence, so readers never block the
+// writer and torn copies are discarded.
+namespace Snapshot {
+
+constexpr const char* DEFAULT_NAME = "/htop_clone";
+constexpr uint32_t MAGIC = 0x48545043; // "HTPC"
+constexpr uint32_t VERSION = 3;
+constexpr uint32_t PROCESS_CAPACITY = 65536;
+constexpr uint32_t GROUP_CAPACITY = 4096;
+
+struct ProcessRecord {
+    int32_t pid;
+    uint32_t group;
+    int64_t startTime;
+    char name[32];
+    double cpuUsage;
+    double memUsage;
+    int64_t elapsedTime;
+    int64_t pssKb;
+    int64_t ussKb;
+    int64_t smapsSampledAtNs;
+};
+
+struct GroupRecord {
+    char path[256];
+    int32_t procCount;
+    double cpuUsage;
+    double memUsage;
+    double cgroupCpu;
+    int64_t memoryCurrentKb;
+    double cpuPressure;
+    double memPressure;
+};
+
+struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t processRecordSize;
+    uint32_t groupRecordSize;
+    uint32_t processCapacity;
+    uint32_t groupCapacity;
+    std::atomic<uint64_t> sequence;
+    uint32_t processCount;
+    uint32_t groupCount;
+    int64_t publishedAtNs;
+    double systemCpuUsage;
+    double systemMemUsage;
+};
+
+class Publisher {
+public:
+    explicit Publisher(std::string name = DEFAULT_NAME);
+    ~Publisher();
+
+    Publisher(const Publisher&) = delete;
+    Publisher& operator=(const Publisher&) = delete;
+
+    bool open();
+    void publish(const std::vector<Process>& processes,
+                 const std::vector<CgroupStats>& groups,
+                 const SystemStats& system);
+
+    const std::string& errorMessage() const;
+
+private:
+    std::string name;
+    std::string error;
+    int fd{-1};
+    void* mapping{nullptr};
+    size_t mappingSize{0};
+};
+
+enum class ReadResult { UPDATED, UNCHANGED, FAILED };
+
+class Reader {
+public:
+    explicit Reader(std::string name = DEFAULT_NAME);
+    ~Reader();
+
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    bool open();
+    // UNCHANGED when the collector has not published since the last
+    // successful read; the output vectors are left untouched then.
+    ReadResult read(std::vector<Process>& processes, std::vector<CgroupStats>& groups,
+                    SystemStats& system);
+
+    // Seconds since the collector last published; negative before the first read.
+    double snapshotAge() const;
+
+    const std::string& errorMessage() const;
+
+private:
+    static constexpr int MAX_ATTEMPTS = 64;
+    // A collector that restarts unlinks its segment and creates a new one,
+    // which this reader would never see through its old mapping. Once no
+    // snapshot has arrived for this long, the name is checked (at most this
+    // often) and remapped if it now refers to a different segment.
+    static constexpr std::chrono::seconds REOPEN_AFTER{3};
+
+    std::string name;
+    std::string error;
+    const void* mapping{nullptr};
+    size_t mappingSize{0};
+    int64_t lastPublishedAtNs{-1};
+    uint64_t lastSequence{0};
+    dev_t device{};
+    ino_t inode{};
+    std::chrono::steady_clock::time_point lastReopenCheck{};
+
+    bool segmentReplaced() const;
+
+    std::vector<ProcessRecord> processBuf;
+    std::vector<GroupRecord> groupBuf;
+};
+
+}
+
+#endif
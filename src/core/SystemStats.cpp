@@ -0,0 +1,64 @@
+#include "core/SystemStats.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+SystemStats SystemStatsSampler::sample() {
+    return SystemStats{sampleCpuUsage(), sampleMemUsage()};
+}
+
+double SystemStatsSampler::sampleCpuUsage() {
+    std::ifstream statFile("/proc/stat");
+    if (!statFile.is_open()) return 0.0;
+
+    std::string line;
+    std::getline(statFile, line);
+    statFile.close();
+
+    std::istringstream iss(line);
+    std::string cpuLabel;
+    long user=0, nice=0, system=0, idle=0, iowait=0, irq=0, softirq=0, steal=0;
+    iss >> cpuLabel >> user >> nice >> system >> idle >> iowait >> irq >> softirq >> steal;
+
+    long idleAll = idle + iowait;
+    long nonIdle = user + nice + system + irq + softirq + steal;
+    long total   = idleAll + nonIdle;
+
+    long totalDiff = total - prevTotalCpuJiffies;
+    long idleDiff  = idleAll - prevIdleCpuJiffies;
+
+    double cpuPercent = 0.0;
+    if (totalDiff > 0) {
+        cpuPercent = 100.0 * (static_cast<double>(totalDiff - idleDiff) / totalDiff);
+    }
+
+    prevTotalCpuJiffies = total;
+    prevIdleCpuJiffies  = idleAll;
+
+    return cpuPercent;
+}
+
+double SystemStatsSampler::sampleMemUsage() {
+    std::ifstream memFile("/proc/meminfo");
+    if (!memFile.is_open()) return 0.0;
+
+    long memTotalKb = 0, memAvailableKb = 0;
+    std::string label;
+    while (memFile >> label) {
+        if (label == "MemTotal:") {
+            memFile >> memTotalKb;
+        } else if (label == "MemAvailable:") {
+            memFile >> memAvailableKb;
+            break;
+        } else {
+            std::string tmp;
+            std::getline(memFile, tmp);
+        }
+    }
+    memFile.close();
+
+    if (memTotalKb <= 0) return 0.0;
+    long usedKb = memTotalKb - memAvailableKb;
+    return 100.0 * (static_cast<double>(usedKb) / memTotalKb);
+}
@@ -0,0 +1,24 @@
+#ifndef HTOP_CLONE_SYSTEM_STATS_HPP
+#define HTOP_CLONE_SYSTEM_STATS_HPP
+
+// Machine-wide utilisation shown in the stats window, in percent.
+struct SystemStats {
+    double cpuUsage{0.0};
+    double memUsage{0.0};
+};
+
+// Samples SystemStats from /proc/stat and /proc/meminfo. CPU usage is the
+// busy share of the jiffies elapsed since the previous sample.
+class SystemStatsSampler {
+public:
+    SystemStats sample();
+
+private:
+    long prevTotalCpuJiffies{0};
+    long prevIdleCpuJiffies{0};
+
+    double sampleCpuUsage();
+    double sampleMemUsage();
+};
+
+#endif
@@ -1,7 +1,88 @@
 #include "core/ProcessManager.hpp"
+#include "core/SnapshotChannel.hpp"
 #include "ui/UI.hpp"
 
-int main() {
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+
+static volatile std::sig_atomic_t stopRequested = 0;
+
+static void onStopSignal(int) {
+    stopRequested = 1;
+}
+
+static void printUsage(const char* argv0) {
+    std::fprintf(stderr,
+                 "usage: %s [--daemon | --attach] [--shm NAME]\n"
+                 "  --daemon    collect from /proc and publish snapshots to shared memory\n"
+                 "  --attach    render snapshots published by a running --daemon\n"
+                 "  --shm NAME  shared-memory segment name (default %s)\n",
+                 argv0, Snapshot::DEFAULT_NAME);
+}
+
+static int runDaemon(const std::string& shmName) {
+    Snapshot::Publisher publisher(shmName);
+    if (!publisher.open()) {
+        std::fprintf(stderr, "htop_clone: %s\n", publisher.errorMessage().c_str());
+        return 1;
+    }
+
+    std::signal(SIGINT, onStopSignal);
+    std::signal(SIGTERM, onStopSignal);
+
+    ProcessManager pm;
+    pm.setPublisher(&publisher);
+    while (!stopRequested) {
+        pm.refresh();
+        for (int i = 0; i < 10 && !stopRequested; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
+    return 0;
+}
+
+static int runAttached(const std::string& shmName) {
+    Snapshot::Reader reader(shmName);
+    if (!reader.open()) {
+        std::fprintf(stderr, "htop_clone: %s\n", reader.errorMessage().c_str());
+        return 1;
+    }
+
+    ProcessManager pm(&reader);
+    UI ui(pm);
+    ui.run();
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    bool daemon = false, attach = false;
+    std::string shmName = Snapshot::DEFAULT_NAME;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--daemon") == 0) {
+            daemon = true;
+        } else if (std::strcmp(argv[i], "--attach") == 0) {
+            attach = true;
+        } else if (std::strcmp(argv[i], "--shm") == 0 && i + 1 < argc) {
+            shmName = argv[++i];
+            if (shmName.empty() || shmName.front() != '/') shmName.insert(0, "/");
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+    if (daemon && attach) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    if (daemon) return runDaemon(shmName);
+    if (attach) return runAttached(shmName);
+
     ProcessManager pm;
     UI ui(pm);
     ui.run();
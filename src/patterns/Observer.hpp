@@ -1,10 +1,29 @@
 #ifndef HTOP_CLONE_OBSERVER_HPP
 #define HTOP_CLONE_OBSERVER_HPP
 
+#include <cstdint>
+#include "utils/Span.hpp"
+
+struct ProcessChange {
+	enum Field : uint8_t { CPU = 1, MEM = 2, PSS = 4 };
+
+	int pid;
+	uint32_t index;  // into ProcessManager::getProcesses(), valid until the next refresh
+	uint8_t fields;  // bitmask of Field
+};
+
+// What changed in one refresh. The spans point into ProcessManager's
+// buffers and are only valid for the duration of onUpdate().
+struct ProcessDelta {
+	Templates::Span<const int> added;
+	Templates::Span<const int> exited;
+	Templates::Span<const ProcessChange> changed;
+};
+
 class IObserver {
 public:
 	virtual ~IObserver() = default;
-	virtual void onUpdate() = 0;
+	virtual void onUpdate(const ProcessDelta& delta) = 0;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -7,16 +7,18 @@
 #include <cctype>   
 #include <csignal>  
 #include <cerrno>   
-#include <fstream>
 #include <sstream>
 #include <vector>
 #include <cmath>
 #include <iomanip>  
 #include <cstring>  
+#include <cstdio>
 
 static constexpr double CPU_GREEN_THRESHOLD  = 30.0;
 static constexpr double CPU_YELLOW_THRESHOLD = 70.0;
 
+static constexpr int HISTORY_GRAPH_HEIGHT = 8;
+
 static constexpr short CP_COLOR_DEFAULT     = 1;
 static constexpr short CP_COLOR_RED         = 2;
 static constexpr short CP_COLOR_YELLOW      = 3;
@@ -48,9 +50,6 @@ UI::UI(ProcessManager& pm)
     }
 
     initializeWindows();
-
-    prevTotalCpuJiffies = prevIdleCpuJiffies = 0;
-    getTotalCpuUsage();
 }
 
 UI::~UI() {
@@ -58,29 +57,72 @@ UI::~UI() {
     endwin();
 }
 
-void UI::onUpdate() {}
+void UI::onUpdate(const ProcessDelta& delta) {
+    lastAdded = delta.added.size();
+    lastExited = delta.exited.size();
+    lastChanged = delta.changed.size();
+}
 
-bool UI::nameMatchesFilter(const std::string& name) const {
-    if (filterStr.empty()) return true;
-    auto it = std::search(
-        name.begin(), name.end(),
-        filterStr.begin(), filterStr.end(),
-        [](char c1, char c2){
-            return std::tolower(c1) == std::tolower(c2);
-        }
-    );
-    return it != name.end();
+void UI::commitFilter() {
+    appliedFilterStr = filterStr;
+    if (!filter.compile(filterStr)) {
+        filter.compileNameContains(filterStr);
+    }
 }
 
-std::vector<Process> UI::filteredProcesses() const {
-    std::vector<Process> vec;
+void UI::applyFilter() {
     const auto& all = pm.getProcesses();
-    for (const auto& p : all) {
-        if (nameMatchesFilter(p.getName())) {
-            vec.push_back(p);
-        }
+    filter.evaluate(pm.getColumns(), filterMask);
+    visible.clear();
+    for (size_t i = 0; i < all.size(); ++i) {
+        if (!filterMask[i]) continue;
+        if (drillCgroup && all[i].getCgroup() != *drillCgroup) continue;
+        visible.push_back(&all[i]);
+    }
+
+    Templates::PROCESS_COLUMNS[procSortColumn].sort(visible, procSortOrder);
+
+    visibleGroups.clear();
+    for (const auto& g : pm.getCgroups().getGroups()) {
+        visibleGroups.push_back(&g);
     }
-    return vec;
+    Templates::CGROUP_COLUMNS[groupSortColumn].sort(visibleGroups, groupSortOrder);
+}
+
+void UI::signalSelected(int sig) {
+    if (groupView || selectedIndex >= static_cast<int>(visible.size())) return;
+    // The row may be a tick old, or come from another collector's snapshot,
+    // so the pid could have been reused since it was read.
+    const Process& p = *visible[selectedIndex];
+    if (!p.isStillRunning()) {
+        beep();
+        return;
+    }
+    kill(p.getPid(), sig);
+}
+
+bool UI::selectSortColumn(int ch) {
+    if (ch < 0 || ch > 127) return false;
+    char key = static_cast<char>(std::tolower(ch));
+
+    size_t& column = groupView ? groupSortColumn : procSortColumn;
+    Templates::Order& order = groupView ? groupSortOrder : procSortOrder;
+    int idx = groupView ? Templates::findHotkey(Templates::CGROUP_COLUMNS, key)
+                        : Templates::findHotkey(Templates::PROCESS_COLUMNS, key);
+    if (idx < 0) return false;
+
+    if (static_cast<size_t>(idx) == column) {
+        order = order == Templates::Order::ASC ? Templates::Order::DESC : Templates::Order::ASC;
+    } else {
+        column = static_cast<size_t>(idx);
+        order = groupView ? Templates::CGROUP_COLUMNS[column].defaultOrder
+                          : Templates::PROCESS_COLUMNS[column].defaultOrder;
+    }
+    return true;
+}
+
+int UI::listSize() const {
+    return static_cast<int>(groupView ? visibleGroups.size() : visible.size());
 }
 
 void UI::initializeWindows() {
@@ -132,65 +174,27 @@ void UI::resizeWindowsIfNeeded() {
     werase(winFilter);
 }
 
-double UI::getTotalCpuUsage() {
-    std::ifstream statFile("/proc/stat");
-    if (!statFile.is_open()) return 0.0;
-
-    std::string line;
-    std::getline(statFile, line);
-    statFile.close();
-
-    std::istringstream iss(line);
-    std::string cpuLabel;
-    long user=0, nice=0, system=0, idle=0, iowait=0, irq=0, softirq=0, steal=0;
-    iss >> cpuLabel >> user >> nice >> system >> idle >> iowait >> irq >> softirq >> steal;
-
-    long idleAll = idle + iowait;
-    long nonIdle = user + nice + system + irq + softirq + steal;
-    long total   = idleAll + nonIdle;
-
-    long totalDiff = total - prevTotalCpuJiffies;
-    long idleDiff  = idleAll - prevIdleCpuJiffies;
-
-    double cpuPercent = 0.0;
-    if (totalDiff > 0) {
-        cpuPercent = 100.0 * (static_cast<double>(totalDiff - idleDiff) / totalDiff);
-    }
-
-    prevTotalCpuJiffies = total;
-    prevIdleCpuJiffies  = idleAll;
-
-    return cpuPercent;
+void UI::drawFilterPrompt() {
+    werase(winFilter);
+    mvwprintw(winFilter, 0, 0, "/%s", filterStr.c_str());
+    wclrtoeol(winFilter);
+    wrefresh(winFilter);
 }
 
-double UI::getTotalMemUsage() {
-    std::ifstream memFile("/proc/meminfo");
-    if (!memFile.is_open()) return 0.0;
-
-    long memTotalKb = 0, memAvailableKb = 0;
-    std::string label;
-    while (memFile >> label) {
-        if (label == "MemTotal:") {
-            memFile >> memTotalKb;
-        } else if (label == "MemAvailable:") {
-            memFile >> memAvailableKb;
-            break;
+void UI::drawFilterStatus() {
+    werase(winFilter);
+    if (drillCgroup) {
+        wprintw(winFilter, "cgroup: %s  ",
+                drillCgroup->empty() ? "(unknown)" : drillCgroup->c_str());
+    }
+    if (!filter.empty()) {
+        if (filter.errorMessage().empty()) {
+            wprintw(winFilter, "filter: %s", appliedFilterStr.c_str());
         } else {
-            std::string tmp;
-            std::getline(memFile, tmp);
+            wprintw(winFilter, "filter: name ~ \"%s\" (%s)",
+                      appliedFilterStr.c_str(), filter.errorMessage().c_str());
         }
     }
-    memFile.close();
-
-    if (memTotalKb <= 0) return 0.0;
-    long usedKb = memTotalKb - memAvailableKb;
-    return 100.0 * (static_cast<double>(usedKb) / memTotalKb);
-}
-
-void UI::drawFilterPrompt() {
-    werase(winFilter);
-    mvwprintw(winFilter, 0, 0, "/%s", filterStr.c_str());
-    wclrtoeol(winFilter);
     wrefresh(winFilter);
 }
 
@@ -199,16 +203,54 @@ void UI::drawSpinner(int row, int col) {
     spinnerIdx = (spinnerIdx + 1) % 4;
 }
 
+void UI::drawHistoryGraph(int top, int height, int width, const Process& p) {
+    const auto& history = pm.getHistory();
+    uint8_t cpu[ProcessHistory::CAPACITY];
+    uint8_t mem[ProcessHistory::CAPACITY];
+    size_t maxSamples = std::min<size_t>(ProcessHistory::CAPACITY,
+                                         static_cast<size_t>(std::max(0, width - 7)));
+    size_t nCpu = history.copySamples(p.getPid(), ProcessHistory::Metric::CPU, cpu, maxSamples);
+    size_t nMem = history.copySamples(p.getPid(), ProcessHistory::Metric::MEM, mem, maxSamples);
+
+    mvwhline(winProcs, top, 1, ACS_HLINE, width);
+    mvwprintw(winProcs, top, 2, " HISTORY %d %.20s ", p.getPid(), p.getName().c_str());
+
+    int barRows = height - 2;
+    for (int r = 0; r < barRows; ++r) {
+        int row = top + 1 + r;
+        double threshold = 100.0 * (barRows - r - 0.5) / barRows;
+        if (r == 0) mvwprintw(winProcs, row, 1, "%4d%% ", 100);
+        else if (r == barRows - 1) mvwprintw(winProcs, row, 1, "%4d%% ", 0);
+        for (size_t i = 0; i < nCpu; ++i) {
+            if (ProcessHistory::toPercent(ProcessHistory::Metric::CPU, cpu[i]) >= threshold) {
+                mvwaddch(winProcs, row, 7 + static_cast<int>(i), ACS_CKBOARD);
+            }
+        }
+    }
+
+    int memRow = top + height - 1;
+    mvwprintw(winProcs, memRow, 1, "  MEM ");
+    for (size_t i = 0; i < nMem; ++i) {
+        mvwaddch(winProcs, memRow, 7 + static_cast<int>(i), Templates::sparkChar(mem[i]));
+    }
+}
+
 void UI::drawStats() {
     werase(winStats);
     box(winStats, 0, 0);
-    mvwprintw(winStats, 0, 2, " SYSTEM USAGE ");
+    if (pm.isAttached()) {
+        mvwprintw(winStats, 0, 2, " SYSTEM USAGE (attached, snapshot %.0fs old) ",
+                  std::max(0.0, pm.getSnapshotAge()));
+    } else {
+        mvwprintw(winStats, 0, 2, " SYSTEM USAGE ");
+    }
 
     int wRows, wCols;
     getmaxyx(winStats, wRows, wCols);
 
-    double totalCpu = getTotalCpuUsage();
-    double totalMem = getTotalMemUsage();
+    const SystemStats& system = pm.getSystemStats();
+    double totalCpu = system.cpuUsage;
+    double totalMem = system.memUsage;
 
     std::ostringstream tmpCpu;
     tmpCpu << "CPU Total: " << std::fixed << std::setprecision(2) << totalCpu << "% ";
@@ -272,45 +314,71 @@ void UI::drawStats() {
         wattroff(winStats, COLOR_PAIR(CP_COLOR_RED));
     }
 
+    char histBuf[16];
+    Templates::formatKb(static_cast<long>(pm.getHistory().bytesReserved() / 1024), histBuf, sizeof(histBuf));
+    mvwprintw(winStats, 3, 2, " history: %zu procs, %s ",
+              pm.getHistory().trackedCount(), histBuf);
+
     wrefresh(winStats);
 }
 
+// Column tables can be wider than the window; clip instead of letting
+// ncurses wrap the tail over the border and the next row.
+void UI::drawListLine(int row, const std::string& line) {
+    int room = getmaxx(winProcs) - 2;
+    if (room > 0) mvwaddnstr(winProcs, row, 1, line.c_str(), room);
+}
+
 void UI::drawProcHeader() {
     mvwprintw(winProcs, 0, 2, " PROCESS LIST ");
-    if (has_colors()) {
-        wattron(winProcs, COLOR_PAIR(CP_COLOR_HEADER_BG));
-        mvwprintw(winProcs, 1, 1, "%-6s %-20s %6s %6s %8s",
-                  "PID", "NAME", "CPU%", "MEM%", "TIME");
-        wattroff(winProcs, COLOR_PAIR(CP_COLOR_HEADER_BG));
-    } else {
-        mvwprintw(winProcs, 1, 1, "%-6s %-20s %6s %6s %8s",
-                  "PID", "NAME", "CPU%", "MEM%", "TIME");
-    }
-}
 
-void UI::drawProcessList() {
-    int wRows, wCols;
-    getmaxyx(winProcs, wRows, wCols);
+    char churn[64];
+    int len = std::snprintf(churn, sizeof(churn), " +%zu -%zu ~%zu ",
+                            lastAdded, lastExited, lastChanged);
+    int wCols = getmaxx(winProcs);
+    if (len > 0 && wCols > len + 20) {
+        mvwprintw(winProcs, 0, wCols - len - 2, "%s", churn);
+    }
 
-    auto procs = filteredProcesses();
-    int totalMatches = static_cast<int>(procs.size());
-    int maxRows = wRows - 3;
+    std::string header = Templates::formatHeader(
+        Templates::PROCESS_COLUMNS,
+        Templates::fittingColumns(Templates::PROCESS_COLUMNS, wCols - 2));
+    if (has_colors()) wattron(winProcs, COLOR_PAIR(CP_COLOR_HEADER_BG));
+    drawListLine(1, header);
+    if (has_colors()) wattroff(winProcs, COLOR_PAIR(CP_COLOR_HEADER_BG));
+}
 
+void UI::clampScroll(int totalRows, int maxRows) {
     if (selectedIndex < 0) selectedIndex = 0;
-    if (selectedIndex >= totalMatches)
-        selectedIndex = std::max(0, totalMatches - 1);
+    if (selectedIndex >= totalRows)
+        selectedIndex = std::max(0, totalRows - 1);
 
     if (selectedIndex < offset) {
         offset = selectedIndex;
     } else if (selectedIndex >= offset + maxRows) {
         offset = selectedIndex - maxRows + 1;
     }
-    if (offset > totalMatches - maxRows) {
-        offset = std::max(0, totalMatches - maxRows);
+    if (offset > totalRows - maxRows) {
+        offset = std::max(0, totalRows - maxRows);
     }
+}
 
+void UI::drawProcessList() {
+    int wRows, wCols;
+    getmaxyx(winProcs, wRows, wCols);
+
+    const auto& procs = visible;
+    int totalMatches = static_cast<int>(procs.size());
+    int maxRows = wRows - 3;
+    bool graphVisible = showHistory && maxRows > HISTORY_GRAPH_HEIGHT * 2;
+    if (graphVisible) maxRows -= HISTORY_GRAPH_HEIGHT;
+
+    clampScroll(totalMatches, maxRows);
+
+    Templates::RowContext<Process> context{&pm.getHistory()};
+    size_t columns = Templates::fittingColumns(Templates::PROCESS_COLUMNS, wCols - 2);
     for (int i = 0; i < maxRows && (offset + i) < totalMatches; ++i) {
-        const auto& p = procs[offset + i];
+        const Process& p = *procs[offset + i];
         int screenRow = i + 2;
         bool isSelected = (offset + i) == selectedIndex;
         bool isAltRow   = ((offset + i) % 2) != 0;
@@ -331,13 +399,8 @@ void UI::drawProcessList() {
             }
         }
 
-        mvwprintw(winProcs, screenRow, 1,
-                  "%-6d %-20.20s %6.2f %6.2f %8ld",
-                  p.getPid(),
-                  p.getName().c_str(),
-                  p.getCpuUsage(),
-                  p.getMemUsage(),
-                  p.getElapsedTime());
+        std::string line = Templates::formatRow(Templates::PROCESS_COLUMNS, p, context, columns);
+        drawListLine(screenRow, line);
 
         if (has_colors() && !isSelected) {
             wattroff(winProcs, COLOR_PAIR(CP_COLOR_RED));
@@ -352,14 +415,69 @@ void UI::drawProcessList() {
         }
     }
 
+    if (graphVisible && selectedIndex < totalMatches) {
+        drawHistoryGraph(wRows - 1 - HISTORY_GRAPH_HEIGHT, HISTORY_GRAPH_HEIGHT,
+                         wCols - 2, *procs[selectedIndex]);
+    }
+
     drawSpinner(0, 14 + 2);
     wrefresh(winProcs);
 }
 
+void UI::drawGroupHeader() {
+    mvwprintw(winProcs, 0, 2, " CGROUPS ");
+    std::string header = Templates::formatHeader(
+        Templates::CGROUP_COLUMNS,
+        Templates::fittingColumns(Templates::CGROUP_COLUMNS, getmaxx(winProcs) - 2));
+    if (has_colors()) wattron(winProcs, COLOR_PAIR(CP_COLOR_HEADER_BG));
+    drawListLine(1, header);
+    if (has_colors()) wattroff(winProcs, COLOR_PAIR(CP_COLOR_HEADER_BG));
+}
+
+void UI::drawGroupList() {
+    int wRows, wCols;
+    getmaxyx(winProcs, wRows, wCols);
+    size_t columns = Templates::fittingColumns(Templates::CGROUP_COLUMNS, wCols - 2);
+
+    int totalGroups = static_cast<int>(visibleGroups.size());
+    int maxRows = wRows - 3;
+    clampScroll(totalGroups, maxRows);
+
+    for (int i = 0; i < maxRows && (offset + i) < totalGroups; ++i) {
+        const CgroupStats& g = *visibleGroups[offset + i];
+        bool isSelected = (offset + i) == selectedIndex;
+
+        std::string line = Templates::formatRow(Templates::CGROUP_COLUMNS, g, {}, columns);
+
+        if (isSelected) wattron(winProcs, A_REVERSE);
+        drawListLine(i + 2, line);
+        if (isSelected) wattroff(winProcs, A_REVERSE);
+    }
+
+    drawSpinner(0, 9 + 2);
+    wrefresh(winProcs);
+}
+
+template <typename Row, size_t N>
+static std::string sortKeyHelp(const std::array<Templates::ColumnDescriptor<Row>, N>& table) {
+    std::string help;
+    for (const auto& col : table) {
+        if (col.hotkey == '\0') continue;
+        help += col.hotkey;
+        help += ':';
+        help += col.name;
+        help += ' ';
+    }
+    return help;
+}
+
 void UI::drawHelp() {
     werase(winHelp);
+    std::string sortKeys = groupView ? sortKeyHelp(Templates::CGROUP_COLUMNS)
+                                     : sortKeyHelp(Templates::PROCESS_COLUMNS);
     mvwprintw(winHelp, 0, 0,
-              "q:quit  p:PID  c:CPU  m:MEM  ↑/↓:navigate  PgUp/PgDn:scroll  k:TERM  K:KILL  /:filter");
+              "q:quit  %s h:history  g:cgroups  ↑/↓:navigate  PgUp/PgDn:scroll  k:TERM  K:KILL  /:filter",
+              sortKeys.c_str());
     wrefresh(winHelp);
 }
 
@@ -370,13 +488,20 @@ void UI::draw() {
 
     werase(winProcs);
     box(winProcs, 0, 0);
-    drawProcHeader();
-    drawProcessList();
+    if (groupView) {
+        drawGroupHeader();
+        drawGroupList();
+    } else {
+        drawProcHeader();
+        drawProcessList();
+    }
 
     drawHelp();
 
     if (filtering) {
         drawFilterPrompt();
+    } else {
+        drawFilterStatus();
     }
 }
 
@@ -387,30 +512,31 @@ void UI::run() {
             switch (ch) {
                 case 'q': case 'Q':
                     return;
-                case 'p': case 'P':
-                    sortMode = SortMode::PID;
-                    offset = selectedIndex = 0;
+                case 'h': case 'H':
+                    showHistory = !showHistory;
                     break;
-                case 'c': case 'C':
-                    sortMode = SortMode::CPU;
+                case 'g': case 'G':
+                    groupView = !groupView;
+                    drillCgroup.reset();
+                    applyFilter();
                     offset = selectedIndex = 0;
                     break;
-                case 'm': case 'M':
-                    sortMode = SortMode::MEM;
-                    offset = selectedIndex = 0;
+                case '\n': case '\r': case KEY_ENTER:
+                    if (groupView && selectedIndex < static_cast<int>(visibleGroups.size())) {
+                        drillCgroup = visibleGroups[selectedIndex]->path;
+                        groupView = false;
+                        applyFilter();
+                        offset = selectedIndex = 0;
+                    }
                     break;
                 case KEY_UP:
                     selectedIndex = std::max(0, selectedIndex - 1);
                     break;
-                case KEY_DOWN: {
-                    auto procs = filteredProcesses();
-                    selectedIndex = std::min(static_cast<int>(procs.size()) - 1,
-                                             selectedIndex + 1);
+                case KEY_DOWN:
+                    selectedIndex = std::min(listSize() - 1, selectedIndex + 1);
                     break;
-                }
                 case KEY_NPAGE: {
-                    auto procs = filteredProcesses();
-                    int totalMatches = static_cast<int>(procs.size());
+                    int totalMatches = listSize();
                     selectedIndex = std::min(totalMatches - 1,
                                              selectedIndex + (LINES - 6));
                     break;
@@ -418,20 +544,12 @@ void UI::run() {
                 case KEY_PPAGE:
                     selectedIndex = std::max(0, selectedIndex - (LINES - 6));
                     break;
-                case 'k': {
-                    auto procs = filteredProcesses();
-                    if (selectedIndex < static_cast<int>(procs.size())) {
-                        kill(procs[selectedIndex].getPid(), SIGTERM);
-                    }
+                case 'k':
+                    signalSelected(SIGTERM);
                     break;
-                }
-                case 'K': {
-                    auto procs = filteredProcesses();
-                    if (selectedIndex < static_cast<int>(procs.size())) {
-                        kill(procs[selectedIndex].getPid(), SIGKILL);
-                    }
+                case 'K':
+                    signalSelected(SIGKILL);
                     break;
-                }
                 case '/':
                     filtering = true;
                     filterStr.clear();
@@ -439,15 +557,23 @@ void UI::run() {
                     wrefresh(winFilter);
                     continue;
                 default:
+                    if (selectSortColumn(ch)) {
+                        offset = selectedIndex = 0;
+                    }
                     break;
             }
         } else {
             if (ch == '\n' || ch == KEY_ENTER) {
                 filtering = false;
+                commitFilter();
+                applyFilter();
                 offset = selectedIndex = 0;
             } else if (ch == 27) {
                 filtering = false;
                 filterStr.clear();
+                appliedFilterStr.clear();
+                filter.clear();
+                applyFilter();
                 offset = selectedIndex = 0;
             } else if (ch == KEY_BACKSPACE || ch == 127) {
                 if (!filterStr.empty()) {
@@ -462,11 +588,7 @@ void UI::run() {
         }
 
         pm.refresh();
-        switch (sortMode) {
-            case SortMode::PID: pm.sortByPid(); break;
-            case SortMode::CPU: pm.sortByCpu(); break;
-            case SortMode::MEM: pm.sortByMem(); break;
-        }
+        applyFilter();
         draw();
         std::this_thread::sleep_for(std::chrono::milliseconds(1000));
     }
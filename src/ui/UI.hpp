@@ -3,9 +3,13 @@
 
 #include "patterns/Observer.hpp"
 #include "core/ProcessManager.hpp"
+#include "core/FilterExpression.hpp"
+#include "utils/Templates.hpp"
 
+#include <optional>
 #include <string>
 #include <vector>
+#include <cstdint>
 #include <ncurses.h>
 
 class UI : public IObserver {
@@ -13,24 +17,38 @@ public:
     explicit UI(ProcessManager& pm);
     ~UI();
 
-    void onUpdate() override;
+    void onUpdate(const ProcessDelta& delta) override;
 
     void run();
 
 private:
     ProcessManager& pm;
 
-    enum class SortMode { PID, CPU, MEM };
-    SortMode sortMode{SortMode::PID};
+    size_t procSortColumn{0};
+    Templates::Order procSortOrder{Templates::Order::ASC};
+    size_t groupSortColumn{0};
+    Templates::Order groupSortOrder{Templates::Order::ASC};
 
     int offset{0};
     int selectedIndex{0};
 
+    bool showHistory{false};
+
+    size_t lastAdded{0};
+    size_t lastExited{0};
+    size_t lastChanged{0};
+
+    bool groupView{false};
+    // Set while drilled into one group; the path may be empty ("(unknown)").
+    std::optional<std::string> drillCgroup;
+    std::vector<const CgroupStats*> visibleGroups;
+
     bool filtering{false};
     std::string filterStr;
-
-    long prevTotalCpuJiffies{0};
-    long prevIdleCpuJiffies{0};
+    std::string appliedFilterStr;
+    FilterExpression filter;
+    std::vector<uint8_t> filterMask;
+    std::vector<const Process*> visible;
 
     WINDOW* winStats{nullptr};
     WINDOW* winProcs{nullptr};
@@ -46,17 +64,23 @@ private:
 
     void draw();
     void drawStats();
+    void drawListLine(int row, const std::string& line);
     void drawProcHeader();
     void drawProcessList();
+    void drawGroupHeader();
+    void drawGroupList();
+    void clampScroll(int totalRows, int maxRows);
     void drawHelp();
     void drawFilterPrompt();
+    void drawFilterStatus();
     void drawSpinner(int row, int col);
+    void drawHistoryGraph(int top, int height, int width, const Process& p);
 
-    double getTotalCpuUsage();
-    double getTotalMemUsage();
-
-    bool nameMatchesFilter(const std::string& name) const;
-    std::vector<Process> filteredProcesses() const;
+    void commitFilter();
+    void applyFilter();
+    int listSize() const;
+    bool selectSortColumn(int ch);
+    void signalSelected(int sig);
 };
 
 #endif
@@ -0,0 +1,43 @@
+#ifndef HTOP_CLONE_SPAN_HPP
+#define HTOP_CLONE_SPAN_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace Templates {
+
+// Non-owning view over contiguous elements (std::span is C++20).
+template <typename T>
+class Span {
+    // Any contiguous container whose data() converts to T*, including a
+    // Span of a less const-qualified element type; Span itself is left to
+    // the copy constructor.
+    template <typename Container>
+    using IfContainer = std::enable_if_t<
+        !std::is_same_v<std::remove_cv_t<Container>, Span> &&
+        std::is_convertible_v<decltype(std::declval<Container&>().data()), T*> &&
+        std::is_convertible_v<decltype(std::declval<Container&>().size()), size_t>>;
+
+public:
+    constexpr Span() = default;
+    constexpr Span(T* data, size_t size) : ptr(data), count(size) {}
+
+    template <typename Container, typename = IfContainer<Container>>
+    constexpr Span(Container& c) : ptr(c.data()), count(c.size()) {}
+
+    T* data() const { return ptr; }
+    T* begin() const { return ptr; }
+    T* end() const { return ptr + count; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    T& operator[](size_t i) const { return ptr[i]; }
+
+private:
+    T* ptr{nullptr};
+    size_t count{0};
+};
+
+}
+
+#endif
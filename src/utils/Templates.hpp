@@ -3,14 +3,28 @@
 
 #include <vector>
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include "core/Process.hpp"
+#include "core/ProcessHistory.hpp"
+#include "core/CgroupManager.hpp"
 
 namespace Templates {
 
 template <typename T>
 std::vector<T> uniquePreserveOrder(const std::vector<T>& input) {
     std::vector<T> result;
+    std::unordered_set<T> seen;
+    seen.reserve(input.size());
     for (const auto& item : input) {
-        if (std::find(result.begin(), result.end(), item) == result.end()) {
+        if (seen.insert(item).second) {
             result.push_back(item);
         }
     }
@@ -29,6 +43,473 @@ Iter findMaxElement(Iter begin, Iter end, Compare comp) {
     return maxIt;
 }
 
+// ---------------------------------------------------------------------------
+// Column descriptors
+//
+// A column is a struct with static members: name, width, align, truncate,
+// hotkey, defaultOrder, get(row) and format(row, buf, len). Only text
+// columns set truncate; numeric cells overflow their width rather than
+// lose digits. Columns that render state kept outside the row (such as
+// sample history) declare format(row, context, buf, len) instead and read
+// it from RowContext<Row>. Columns that should not be sortable use hotkey
+// '\0'. Sorting composes
+// columns into MultiKeyCompare<SortKey<...>, ...>, which the compiler
+// inlines into std::sort; the only indirect call is the one that selects
+// the sort function. makeColumnTable() turns a column list into a
+// constexpr table the UI iterates to draw headers, rows and key bindings.
+// ---------------------------------------------------------------------------
+
+enum class Order { ASC, DESC };
+enum class Align { LEFT, RIGHT };
+
+template <typename Column, Order O>
+struct SortKey {
+    using column = Column;
+    static constexpr Order order = O;
+};
+
+template <typename... Keys>
+struct MultiKeyCompare;
+
+template <>
+struct MultiKeyCompare<> {
+    template <typename Row>
+    bool operator()(const Row&, const Row&) const { return false; }
+};
+
+template <typename Key, typename... Rest>
+struct MultiKeyCompare<Key, Rest...> {
+    template <typename Row>
+    bool operator()(const Row& a, const Row& b) const {
+        const auto& va = Key::column::get(a);
+        const auto& vb = Key::column::get(b);
+        if (va < vb) return Key::order == Order::ASC;
+        if (vb < va) return Key::order == Order::DESC;
+        return MultiKeyCompare<Rest...>{}(a, b);
+    }
+};
+
+template <typename Row, typename... Keys>
+void sortRows(std::vector<const Row*>& rows) {
+    std::sort(rows.begin(), rows.end(),
+              [](const Row* a, const Row* b){
+                  return MultiKeyCompare<Keys...>{}(*a, *b);
+              });
+}
+
+// State a row is drawn with that does not live in the row itself.
+template <typename Row>
+struct RowContext {};
+
+template <>
+struct RowContext<Process> {
+    const ProcessHistory* history{nullptr};
+};
+
+template <typename Column, typename Row, typename = void>
+struct FormatCell {
+    static void call(const Row& row, const RowContext<Row>&, char* buf, size_t len) {
+        Column::format(row, buf, len);
+    }
+};
+
+template <typename Column, typename Row>
+struct FormatCell<Column, Row, std::void_t<decltype(Column::format(
+    std::declval<const Row&>(), std::declval<const RowContext<Row>&>(),
+    std::declval<char*>(), size_t{}))>> {
+    static void call(const Row& row, const RowContext<Row>& ctx, char* buf, size_t len) {
+        Column::format(row, ctx, buf, len);
+    }
+};
+
+template <typename Row>
+struct ColumnDescriptor {
+    const char* name;
+    int width;
+    Align align;
+    bool truncate;
+    char hotkey;
+    Order defaultOrder;
+    void (*format)(const Row&, const RowContext<Row>&, char*, size_t);
+    void (*sortAsc)(std::vector<const Row*>&);
+    void (*sortDesc)(std::vector<const Row*>&);
+
+    void sort(std::vector<const Row*>& rows, Order order) const {
+        (order == Order::ASC ? sortAsc : sortDesc)(rows);
+    }
+};
+
+// Every column sorts by itself first and then by TieBreak ascending, so
+// equal keys keep a stable, readable order between ticks.
+template <typename Row, typename TieBreak, typename... Columns>
+constexpr std::array<ColumnDescriptor<Row>, sizeof...(Columns)> makeColumnTable() {
+    return {{ ColumnDescriptor<Row>{
+        Columns::name, Columns::width, Columns::align, Columns::truncate,
+        Columns::hotkey, Columns::defaultOrder,
+        &FormatCell<Columns, Row>::call,
+        &sortRows<Row, SortKey<Columns, Order::ASC>,  SortKey<TieBreak, Order::ASC>>,
+        &sortRows<Row, SortKey<Columns, Order::DESC>, SortKey<TieBreak, Order::ASC>>
+    }... }};
+}
+
+// Only the first count columns are formatted; see fittingColumns().
+template <typename Row, size_t N>
+std::string formatCells(const std::array<ColumnDescriptor<Row>, N>& table,
+                        const Row* row, const RowContext<Row>& ctx, size_t count) {
+    std::string line;
+    char cell[64];
+    char padded[96];
+    for (size_t i = 0; i < std::min(count, N); ++i) {
+        const auto& col = table[i];
+        if (row) col.format(*row, ctx, cell, sizeof(cell));
+        const char* text = row ? cell : col.name;
+        if (col.truncate) {
+            std::snprintf(padded, sizeof(padded),
+                          col.align == Align::LEFT ? "%-*.*s" : "%*.*s",
+                          col.width, col.width, text);
+        } else {
+            std::snprintf(padded, sizeof(padded),
+                          col.align == Align::LEFT ? "%-*s" : "%*s",
+                          col.width, text);
+        }
+        if (i) line.push_back(' ');
+        line += padded;
+    }
+    return line;
+}
+
+template <typename Row, size_t N>
+std::string formatHeader(const std::array<ColumnDescriptor<Row>, N>& table, size_t count = N) {
+    return formatCells<Row, N>(table, nullptr, RowContext<Row>{}, count);
+}
+
+template <typename Row, size_t N>
+std::string formatRow(const std::array<ColumnDescriptor<Row>, N>& table, const Row& row,
+                      const RowContext<Row>& ctx = {}, size_t count = N) {
+    return formatCells(table, &row, ctx, count);
+}
+
+// How many leading columns fit in maxWidth characters. A narrow window
+// drops whole trailing columns (the sparkline first) rather than cutting
+// a cell in half; the first column is always kept.
+template <typename Row, size_t N>
+size_t fittingColumns(const std::array<ColumnDescriptor<Row>, N>& table, int maxWidth) {
+    int used = -1;
+    size_t count = 0;
+    while (count < N && used + 1 + table[count].width <= maxWidth) {
+        used += 1 + table[count].width;
+        ++count;
+    }
+    return std::max<size_t>(count, 1);
+}
+
+template <typename Row, size_t N>
+int findHotkey(const std::array<ColumnDescriptor<Row>, N>& table, char key) {
+    for (size_t i = 0; i < N; ++i) {
+        if (table[i].hotkey != '\0' && table[i].hotkey == key) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+inline void formatKb(long kb, char* buf, size_t len) {
+    if (kb < 0) {
+        std::snprintf(buf, len, "-");
+    } else if (kb >= 1024L * 1024L) {
+        std::snprintf(buf, len, "%.1fG", kb / (1024.0 * 1024.0));
+    } else if (kb >= 1024L) {
+        std::snprintf(buf, len, "%.1fM", kb / 1024.0);
+    } else {
+        std::snprintf(buf, len, "%ldK", kb);
+    }
+}
+
+inline void formatAge(double seconds, char* buf, size_t len) {
+    if (seconds < 0.0) {
+        std::snprintf(buf, len, "-");
+    } else {
+        std::snprintf(buf, len, "%lds", static_cast<long>(seconds));
+    }
+}
+
+// Characters for an 8-bit sample, from idle to saturated.
+inline constexpr char SPARK_LEVELS[] = " .:-=+*#%@";
+
+inline char sparkChar(uint8_t sample) {
+    constexpr int levels = static_cast<int>(sizeof(SPARK_LEVELS)) - 2;
+    return SPARK_LEVELS[(sample * levels + 254) / 255];
+}
+
+inline void formatPercent(double value, char* buf, size_t len) {
+    if (value < 0.0) {
+        std::snprintf(buf, len, "-");
+    } else {
+        std::snprintf(buf, len, "%.2f", value);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Process list columns
+// ---------------------------------------------------------------------------
+
+namespace ProcessColumns {
+
+struct Pid {
+    static constexpr const char* name = "PID";
+    static constexpr int width = 6;
+    static constexpr Align align = Align::LEFT;
+    static constexpr bool truncate = false;
+    static constexpr char hotkey = 'p';
+    static constexpr Order defaultOrder = Order::ASC;
+    static int get(const Process& p) { return p.getPid(); }
+    static void format(const Process& p, char* buf, size_t len) {
+        std::snprintf(buf, len, "%d", p.getPid());
+    }
+};
+
+struct Name {
+    static constexpr const char* name = "NAME";
+    static constexpr int width = 20;
+    static constexpr Align align = Align::LEFT;
+    static constexpr bool truncate = true;
+    static constexpr char hotkey = 'n';
+    static constexpr Order defaultOrder = Order::ASC;
+    static const std::string& get(const Process& p) { return p.getName(); }
+    static void format(const Process& p, char* buf, size_t len) {
+        std::snprintf(buf, len, "%s", p.getName().c_str());
+    }
+};
+
+struct Cpu {
+    static constexpr const char* name = "CPU%";
+    static constexpr int width = 6;
+    static constexpr Align align = Align::RIGHT;
+    static constexpr bool truncate = false;
+    static constexpr char hotkey = 'c';
+    static constexpr Order defaultOrder = Order::DESC;
+    static double get(const Process& p) { return p.getCpuUsage(); }
+    static void format(const Process& p, char* buf, size_t len) {
+        std::snprintf(buf, len, "%.2f", p.getCpuUsage());
+    }
+};
+
+struct Mem {
+    static constexpr const char* name = "MEM%";
+    static constexpr int width = 6;
+    static constexpr Align align = Align::RIGHT;
+    static constexpr bool truncate = false;
+    static constexpr char hotkey = 'm';
+    static constexpr Order defaultOrder = Order::DESC;
+    static double get(const Process& p) { return p.getMemUsage(); }
+    static void format(const Process& p, char* buf, size_t len) {
+        std::snprintf(buf, len, "%.2f", p.getMemUsage());
+    }
+};
+
+struct Pss {
+    static constexpr const char* name = "PSS";
+    static constexpr int width = 7;
+    static constexpr Align align = Align::RIGHT;
+    static constexpr bool truncate = false;
+    static constexpr char hotkey = 's';
+    static constexpr Order defaultOrder = Order::DESC;
+    static long get(const Process& p) { return p.getPssKb(); }
+    static void format(const Process& p, char* buf, size_t len) {
+        formatKb(p.getPssKb(), buf, len);
+    }
+};
+
+struct Uss {
+    static constexpr const char* name = "USS";
+    static constexpr int width = 7;
+    static constexpr Align align = Align::RIGHT;
+    static constexpr bool truncate = false;
+    static constexpr char hotkey = 'u';
+    static constexpr Order defaultOrder = Order::DESC;
+    static long get(const Process& p) { return p.getUssKb(); }
+    static void format(const Process& p, char* buf, size_t len) {
+        formatKb(p.getUssKb(), buf, len);
+    }
+};
+
+struct SmapsAge {
+    static constexpr const char* name = "AGE";
+    static constexpr int width = 5;
+    static constexpr Align align = Align::RIGHT;
+    static constexpr bool truncate = false;
+    static constexpr char hotkey = 'a';
+    static constexpr Order defaultOrder = Order::DESC;
+    // Keyed on the sample timestamp so the order does not drift while sorting;
+    // never-sampled rows rank as the youngest.
+    static long long get(const Process& p) {
+        if (p.getPssKb() < 0) return std::numeric_limits<long long>::min();
+        return -static_cast<long long>(p.getSmapsSampledAt().time_since_epoch().count());
+    }
+    static void format(const Process& p, char* buf, size_t len) {
+        formatAge(p.getSmapsAge(), buf, len);
+    }
+};
+
+struct Time {
+    static constexpr const char* name = "TIME";
+    static constexpr int width = 8;
+    static constexpr Align align = Align::RIGHT;
+    static constexpr bool truncate = false;
+    static constexpr char hotkey = 't';
+    static constexpr Order defaultOrder = Order::DESC;
+    static long get(const Process& p) { return p.getElapsedTime(); }
+    static void format(const Process& p, char* buf, size_t len) {
+        std::snprintf(buf, len, "%ld", p.getElapsedTime());
+    }
+};
+
+struct CpuHistory {
+    static constexpr const char* name = "CPU HISTORY";
+    static constexpr int width = 16;
+    static constexpr Align align = Align::LEFT;
+    static constexpr bool truncate = true;
+    static constexpr char hotkey = '\0';
+    static constexpr Order defaultOrder = Order::DESC;
+    static int get(const Process&) { return 0; }
+    static void format(const Process& p, const RowContext<Process>& ctx, char* buf, size_t len) {
+        uint8_t samples[width];
+        size_t n = ctx.history
+            ? ctx.history->copySamples(p.getPid(), ProcessHistory::Metric::CPU, samples, width)
+            : 0;
+        n = std::min(n, len - 1);
+        for (size_t i = 0; i < n; ++i) buf[i] = sparkChar(samples[i]);
+        buf[n] = '\0';
+    }
+};
+
+}
+
+inline constexpr auto PROCESS_COLUMNS = makeColumnTable<
+    Process, ProcessColumns::Pid,
+    ProcessColumns::Pid, ProcessColumns::Name, ProcessColumns::Cpu, ProcessColumns::Mem,
+    ProcessColumns::Pss, ProcessColumns::Uss, ProcessColumns::SmapsAge, ProcessColumns::Time,
+    ProcessColumns::CpuHistory>();
+
+// ---------------------------------------------------------------------------
+// cgroup view columns
+// ---------------------------------------------------------------------------
+
+namespace CgroupColumns {
+
+struct Path {
+    static constexpr const char* name = "CGROUP";
+    static constexpr int width = 40;
+    static constexpr Align align = Align::LEFT;
+    static constexpr bool truncate = true;
+    static constexpr char hotkey = 'n';
+    static constexpr Order defaultOrder = Order::ASC;
+    static const std::string& get(const CgroupStats& g) { return g.path; }
+    static void format(const CgroupStats& g, char* buf, size_t len) {
+        // Keep the tail of long paths: the leaf unit is the informative part.
+        const std::string label = g.path.empty() ? "(unknown)" : g.path;
+        size_t skip = label.size() > static_cast<size_t>(width) ? label.size() - width : 0;
+        std::snprintf(buf, len, "%s", label.c_str() + skip);
+    }
+};
+
+struct Procs {
+    static constexpr const char* name = "PROCS";
+    static constexpr int width = 5;
+    static constexpr Align align = Align::RIGHT;
+    static constexpr bool truncate = false;
+    static constexpr char hotkey = 'p';
+    static constexpr Order defaultOrder = Order::DESC;
+    static int get(const CgroupStats& g) { return g.procCount; }
+    static void format(const CgroupStats& g, char* buf, size_t len) {
+        std::snprintf(buf, len, "%d", g.procCount);
+    }
+};
+
+struct Cpu {
+    static constexpr const char* name = "CPU%";
+    static constexpr int width = 6;
+    static constexpr Align align = Align::RIGHT;
+    static constexpr bool truncate = false;
+    static constexpr char hotkey = 'c';
+    static constexpr Order defaultOrder = Order::DESC;
+    static double get(const CgroupStats& g) { return g.cpuUsage; }
+    static void format(const CgroupStats& g, char* buf, size_t len) {
+        std::snprintf(buf, len, "%.2f", g.cpuUsage);
+    }
+};
+
+struct Mem {
+    static constexpr const char* name = "MEM%";
+    static constexpr int width = 6;
+    static constexpr Align align = Align::RIGHT;
+    static constexpr bool truncate = false;
+    static constexpr char hotkey = 'm';
+    static constexpr Order defaultOrder = Order::DESC;
+    static double get(const CgroupStats& g) { return g.memUsage; }
+    static void format(const CgroupStats& g, char* buf, size_t len) {
+        std::snprintf(buf, len, "%.2f", g.memUsage);
+    }
+};
+
+struct CgroupCpu {
+    static constexpr const char* name = "CG-CPU%";
+    static constexpr int width = 7;
+    static constexpr Align align = Align::RIGHT;
+    static constexpr bool truncate = false;
+    static constexpr char hotkey = 'u';
+    static constexpr Order defaultOrder = Order::DESC;
+    static double get(const CgroupStats& g) { return g.cgroupCpu; }
+    static void format(const CgroupStats& g, char* buf, size_t len) {
+        formatPercent(g.cgroupCpu, buf, len);
+    }
+};
+
+struct MemoryCurrent {
+    static constexpr const char* name = "CG-MEM";
+    static constexpr int width = 7;
+    static constexpr Align align = Align::RIGHT;
+    static constexpr bool truncate = false;
+    static constexpr char hotkey = 'r';
+    static constexpr Order defaultOrder = Order::DESC;
+    static long get(const CgroupStats& g) { return g.memoryCurrentKb; }
+    static void format(const CgroupStats& g, char* buf, size_t len) {
+        formatKb(g.memoryCurrentKb, buf, len);
+    }
+};
+
+struct CpuPressure {
+    static constexpr const char* name = "PSI-CPU";
+    static constexpr int width = 7;
+    static constexpr Align align = Align::RIGHT;
+    static constexpr bool truncate = false;
+    static constexpr char hotkey = 'i';
+    static constexpr Order defaultOrder = Order::DESC;
+    static double get(const CgroupStats& g) { return g.cpuPressure; }
+    static void format(const CgroupStats& g, char* buf, size_t len) {
+        formatPercent(g.cpuPressure, buf, len);
+    }
+};
+
+struct MemPressure {
+    static constexpr const char* name = "PSI-MEM";
+    static constexpr int width = 7;
+    static constexpr Align align = Align::RIGHT;
+    static constexpr bool truncate = false;
+    static constexpr char hotkey = 'o';
+    static constexpr Order defaultOrder = Order::DESC;
+    static double get(const CgroupStats& g) { return g.memPressure; }
+    static void format(const CgroupStats& g, char* buf, size_t len) {
+        formatPercent(g.memPressure, buf, len);
+    }
+};
+
+}
+
+inline constexpr auto CGROUP_COLUMNS = makeColumnTable<
+    CgroupStats, CgroupColumns::Path,
+    CgroupColumns::Path, CgroupColumns::Procs, CgroupColumns::Cpu, CgroupColumns::Mem,
+    CgroupColumns::CgroupCpu, CgroupColumns::MemoryCurrent,
+    CgroupColumns::CpuPressure, CgroupColumns::MemPressure>();
+
 }
 
 #endif